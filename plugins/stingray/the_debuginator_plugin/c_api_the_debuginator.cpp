@@ -13,20 +13,6 @@
 #include <engine_plugin_api\c_api\c_api_keyboard.h>
 #include <limits.h>
 
-struct TheDebuginatorWrapper {
-	TheDebuginator debuginator;
-	char id[64];
-	ConstWindowPtr window;
-	GuiPtr gui;
-	uint64_t font;
-	MaterialPtr font_material;
-	bool memory_owned_by_this_plugin;
-	int font_size;
-	bool axis_selected_repeat;
-	bool axis_scroll_repeat;
-	float scroll_repeat_timer;
-};
-
 struct InputWrapper {
 	InputControllerCApi* api;
 	CApiInputControllerPtr controller;
@@ -70,11 +56,29 @@ struct InputWrapper {
 	}
 };
 
+struct TheDebuginatorWrapper {
+	TheDebuginator debuginator;
+	char id[64];
+	ConstWindowPtr window;
+	GuiPtr gui;
+	uint64_t font;
+	MaterialPtr font_material;
+	bool memory_owned_by_this_plugin;
+	int font_size;
+	bool axis_selected_repeat;
+	bool axis_scroll_repeat;
+	float scroll_repeat_timer;
+	bool in_use;
+	InputWrapper input_wrapper; // Per debuginator so their key repeats don't interfere
+	const char* uisize_titles[4];
+	int uisize_indices[4];
+};
+
 struct PluginMemory {
 	AllocatorObject* allocator_object;
+	// Slots stay put once used since the debuginators point into themselves. in_use marks the live ones.
 	TheDebuginatorWrapper debuginators[8];
 	int num_debuginators = 0;
-	InputWrapper input_wrapper;
 };
 
 static PluginMemory* plugin_memory = nullptr;
@@ -145,7 +149,6 @@ void setup_api(GetApiFunction get_engine_api, const char* plugin_name) {
 		plugin_memory = (PluginMemory*)allocator_api->allocate(allocator_object, sizeof(PluginMemory), 16);
 		memset(plugin_memory, 0, sizeof(*plugin_memory));
 		plugin_memory->allocator_object = allocator_object;
-		plugin_memory->input_wrapper.time_since_pressed = -1;
 	}
 }
 
@@ -153,7 +156,7 @@ void shutdown_api() {
 	if (plugin_memory != nullptr) {
 		for (int i = 0; i < plugin_memory->num_debuginators; i++) {
 			TheDebuginatorWrapper* wrapper = &plugin_memory->debuginators[i];
-			if (wrapper->memory_owned_by_this_plugin) {
+			if (wrapper->in_use && wrapper->memory_owned_by_this_plugin) {
 				allocator_api->deallocate(plugin_memory->allocator_object, wrapper->debuginator.memory_arena);
 			}
 		}
@@ -176,6 +179,9 @@ void finish_reload(GetApiFunction get_engine_api, void *state) {
 void update_debuginators(float dt) {
 	for (int i = 0; i < plugin_memory->num_debuginators; i++) {
 		TheDebuginatorWrapper* wrapper = &plugin_memory->debuginators[i];
+		if (!wrapper->in_use) {
+			continue;
+		}
 
 		CApiVector2 resolution = script_api->Gui->resolution(NULL, wrapper->window);
 		wrapper->debuginator.size.y = resolution.y;
@@ -185,10 +191,9 @@ void update_debuginators(float dt) {
 		debuginator_draw(&wrapper->debuginator, dt);
 
 		wrapper->scroll_repeat_timer += dt;
-	}
-
-	if (plugin_memory->input_wrapper.time_since_pressed != -1) {
-		plugin_memory->input_wrapper.time_since_pressed += dt;
+		if (wrapper->input_wrapper.time_since_pressed != -1) {
+			wrapper->input_wrapper.time_since_pressed += dt;
+		}
 	}
 }
 
@@ -200,12 +205,18 @@ TheDebuginator* create_debuginator(const char* id, DebuginatorPluginCreateContex
 		id = "default";
 	}
 
-	XASSERT(plugin_memory->num_debuginators < 8, "Too many debuginators created. Good lord, how many do you need?!");
 	XASSERT(get_debuginator(id) == NULL, "Debuginator with that name already exists.");
 
-	TheDebuginatorWrapper* wrapper = &plugin_memory->debuginators[plugin_memory->num_debuginators];
+	int slot = 0;
+	while (slot < plugin_memory->num_debuginators && plugin_memory->debuginators[slot].in_use) {
+		slot++;
+	}
+
+	XASSERT(slot < 8, "Too many debuginators created. Good lord, how many do you need?!");
+	TheDebuginatorWrapper* wrapper = &plugin_memory->debuginators[slot];
 	memset(wrapper, 0, sizeof(TheDebuginatorWrapper));
-	strcpy_s(wrapper->id, sizeof(plugin_memory->debuginators[plugin_memory->num_debuginators].id), id);
+	strcpy_s(wrapper->id, sizeof(wrapper->id), id);
+	wrapper->input_wrapper.time_since_pressed = -1;
 
 	wrapper->window = context->window;
 	wrapper->font = context->font;
@@ -238,19 +249,28 @@ TheDebuginator* create_debuginator(const char* id, DebuginatorPluginCreateContex
 	debuginator_create(&context->config, debuginator);
 
 	{
-		static const char* uisize_titles[4] = { "Small", "Medium", "Large", "ULTRA LARGE" };
-		static int uisize_indices[4] = { 0, 1, 2, 3 };
+		wrapper->uisize_titles[0] = "Small";
+		wrapper->uisize_titles[1] = "Medium";
+		wrapper->uisize_titles[2] = "Large";
+		wrapper->uisize_titles[3] = "ULTRA LARGE";
+		for (int i = 0; i < 4; i++) {
+			wrapper->uisize_indices[i] = i;
+		}
+
 		DebuginatorItem* uisize_item = debuginator_create_array_item(debuginator, NULL, "Debuginator/UI size",
 			"Change font and item size.", on_change_ui_size, wrapper,
-			uisize_titles, uisize_indices, 4, sizeof(uisize_indices[0]));
+			wrapper->uisize_titles, wrapper->uisize_indices, 4, sizeof(wrapper->uisize_indices[0]));
 
-		uisize_item->leaf.default_index = 1;
+		debuginator_set_default_value(debuginator, "Debuginator/UI size", NULL, 1);
 		uisize_item->leaf.hot_index = 1;
-		uisize_item->leaf.active_index = 1;
 		debuginator_activate(debuginator, uisize_item, false);
 	}
 
-	plugin_memory->num_debuginators++;
+	wrapper->in_use = true;
+	if (slot == plugin_memory->num_debuginators) {
+		plugin_memory->num_debuginators++;
+	}
+
 	return debuginator;
 }
 
@@ -260,13 +280,13 @@ void destroy_debuginator(TheDebuginator* debuginator) {
 	}
 
 	for (int i = 0; i < plugin_memory->num_debuginators; i++) {
-		if (debuginator == &plugin_memory->debuginators[i].debuginator) {
-			TheDebuginatorWrapper* wrapper = &plugin_memory->debuginators[i];
+		TheDebuginatorWrapper* wrapper = &plugin_memory->debuginators[i];
+		if (wrapper->in_use && debuginator == &wrapper->debuginator) {
 			if (wrapper->memory_owned_by_this_plugin) {
 				allocator_api->deallocate(plugin_memory->allocator_object, debuginator->memory_arena);
 			}
 
-			plugin_memory->debuginators[i] = plugin_memory->debuginators[--plugin_memory->num_debuginators];
+			wrapper->in_use = false;
 			break;
 		}
 	}
@@ -278,7 +298,7 @@ TheDebuginator* get_debuginator(const char* id) {
 	}
 
 	for (int i = 0; i < plugin_memory->num_debuginators; i++) {
-		if (strcmp(id, plugin_memory->debuginators[i].id) == 0) {
+		if (plugin_memory->debuginators[i].in_use && strcmp(id, plugin_memory->debuginators[i].id) == 0) {
 			return &plugin_memory->debuginators[i].debuginator;
 		}
 	}
@@ -294,7 +314,7 @@ void handle_default_input(TheDebuginator* debuginator, unsigned devices) {
 	TheDebuginatorWrapper* wrapper = (TheDebuginatorWrapper*)debuginator;
 
 	InputControllerCApi* api = script_api->Input->InputController;
-	InputWrapper& input_wrapper = plugin_memory->input_wrapper;
+	InputWrapper& input_wrapper = wrapper->input_wrapper;
 	input_wrapper.api = api;
 
 	if (!script_api->Window->has_focus(wrapper->window)) {
@@ -0,0 +1,248 @@
+// Golden image tests and draw path benchmark using the CPU framebuffer backend.
+// On Linux: gcc -std=c99 -O2 headless.c headless_gui.c -lm -o headless && ./headless
+// Pass --update to print the hashes of the current output instead of testing against them,
+// failing frames are written to headless_<name>.ppm next to the executable.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifndef __cplusplus
+#include <stdbool.h>
+#endif
+
+typedef struct HeadlessTestData {
+	bool bools[8];
+	bool update_goldens;
+	int golden_count;
+	int error_count;
+	int assert_count;
+} HeadlessTestData;
+
+static HeadlessTestData g_testdata;
+
+static void headless_debuginator_assert(bool test) {
+	if (!test) {
+		++g_testdata.assert_count;
+	}
+}
+
+#define DEBUGINATOR_assert headless_debuginator_assert
+
+#ifndef _MSC_VER
+// The library defaults to the Annex K string functions which only MSVC ships.
+static int headless_strcpy_s(char* destination, size_t size, const char* source) {
+	snprintf(destination, size, "%s", source);
+	return 0;
+}
+
+#define DEBUGINATOR_strcpy_s headless_strcpy_s
+#endif
+
+#define DEBUGINATOR_IMPLEMENTATION
+#include "headless_gui.h"
+
+#define FRAMEBUFFER_WIDTH 800
+#define FRAMEBUFFER_HEIGHT 600
+#define BACKGROUND_COLOR 0xff202020u
+
+static uint32_t g_pixels[FRAMEBUFFER_WIDTH * FRAMEBUFFER_HEIGHT];
+static HeadlessFramebuffer g_framebuffer = { g_pixels, FRAMEBUFFER_WIDTH, FRAMEBUFFER_HEIGHT };
+
+typedef struct HeadlessGolden {
+	const char* name;
+	uint64_t hash;
+} HeadlessGolden;
+
+// Regenerate with --update after intentional visual changes, and look at the images first.
+static const HeadlessGolden s_goldens[] = {
+	{ "closed", 0xa4185b7b9d121b25ull },
+	{ "open", 0x6ebcce6c18c80509ull },
+	{ "expanded", 0x75f45504c07681e9ull },
+	{ "filtered", 0x9406852d07551e69ull },
+	{ "description", 0x590ae3d3c3b49201ull },
+};
+
+static void headless_menu_setup(TheDebuginator* debuginator) {
+	debuginator_create_bool_item(debuginator, "SimpleBool 1", "Change a bool.", &g_testdata.bools[0]);
+	debuginator_create_bool_item(debuginator, "Folder/SimpleBool 2", "Change a bool.", &g_testdata.bools[1]);
+	debuginator_create_bool_item(debuginator, "Folder/SimpleBool 3", "Change a bool.", &g_testdata.bools[2]);
+	debuginator_create_bool_item(debuginator, "Folder/SimpleBool 4 with a really really long title", "Change a bool.", &g_testdata.bools[3]);
+
+	static const char* string_titles[3] = { "First value", "Second one", "This is the third." };
+	debuginator_create_array_item(debuginator, NULL, "Folder 2/String item",
+		"A longer description that needs to be word wrapped over a couple of rows to fit the menu.\nAnd a second paragraph.", NULL, NULL,
+		string_titles, NULL, 3, 0);
+}
+
+static void headless_create(TheDebuginator* debuginator, char* memory_arena, int memory_arena_capacity, int item_height, float height) {
+	TheDebuginatorConfig config;
+	debuginator_get_default_config(&config);
+	config.memory_arena = memory_arena;
+	config.memory_arena_capacity = memory_arena_capacity;
+	config.draw_rect = headless_draw_rect;
+	config.draw_text = headless_draw_text;
+	config.word_wrap = headless_word_wrap;
+	config.text_size = headless_text_size;
+	config.app_user_data = &g_framebuffer;
+	config.size.x = 500;
+	config.size.y = height;
+	config.screen_resolution.x = FRAMEBUFFER_WIDTH;
+	config.screen_resolution.y = height;
+	config.focus_height = 0.3f;
+	config.item_height = item_height;
+	config.create_default_debuginator_items = false;
+	config.hot_item_pulse = false; // Depends on the clock, and on libm
+	debuginator_create(&config, debuginator);
+}
+
+// Runs enough fixed steps for every animation to finish, then draws one last frame.
+static void headless_settle(TheDebuginator* debuginator) {
+	for (int i = 0; i < 30; i++) {
+		debuginator_update(debuginator, 0.1f);
+		headless_clear(&g_framebuffer, BACKGROUND_COLOR);
+		debuginator_draw(debuginator, 0.1f);
+	}
+}
+
+static void headless_check_golden(const char* name) {
+	uint64_t hash = headless_hash(&g_framebuffer);
+	if (g_testdata.update_goldens) {
+		printf("\t{ \"%s\", 0x%016llxull },\n", name, (unsigned long long)hash);
+		return;
+	}
+
+	++g_testdata.golden_count;
+	for (size_t i = 0; i < sizeof(s_goldens) / sizeof(s_goldens[0]); i++) {
+		if (strcmp(s_goldens[i].name, name) == 0 && s_goldens[i].hash == hash) {
+			return;
+		}
+	}
+
+	char path[64];
+	snprintf(path, sizeof(path), "headless_%s.ppm", name);
+	headless_write_ppm(&g_framebuffer, path);
+	printf("Golden mismatch: %s (0x%016llx), see %s\n", name, (unsigned long long)hash, path);
+	++g_testdata.error_count;
+}
+
+static void headless_run_goldens(void) {
+	int memory_arena_capacity = 1024 * 1024;
+	char* memory_arena = (char*)malloc(memory_arena_capacity);
+	TheDebuginator debuginator;
+	TheDebuginator* thed = &debuginator;
+	headless_create(thed, memory_arena, memory_arena_capacity, 30, FRAMEBUFFER_HEIGHT);
+	headless_menu_setup(thed);
+
+	headless_settle(thed);
+	headless_check_golden("closed");
+
+	debuginator_set_open(thed, true);
+	headless_settle(thed);
+	headless_check_golden("open");
+
+	debuginator_set_hot_item(thed, "Folder/SimpleBool 3");
+	debuginator_move_to_child(thed, false);
+	headless_settle(thed);
+	headless_check_golden("expanded");
+	debuginator_move_to_parent(thed);
+
+	debuginator_update_filter(thed, "bool");
+	headless_settle(thed);
+	headless_check_golden("filtered");
+	debuginator_update_filter(thed, "");
+
+	debuginator_set_hot_item(thed, "Folder 2/String item");
+	debuginator_move_to_child(thed, false);
+	headless_settle(thed);
+	headless_check_golden("description");
+
+	free(memory_arena);
+}
+
+static double headless_bench_ms_per_frame(TheDebuginator* debuginator, int frames) {
+	clock_t start = clock();
+	for (int i = 0; i < frames; i++) {
+		headless_clear(&g_framebuffer, BACKGROUND_COLOR);
+		debuginator_draw(debuginator, 0.016f);
+	}
+
+	return (double)(clock() - start) * 1000.0 / CLOCKS_PER_SEC / frames;
+}
+
+static void headless_run_bench(void) {
+	int memory_arena_capacity = 4 * 1024 * 1024;
+	char* memory_arena = (char*)malloc(memory_arena_capacity);
+	TheDebuginator debuginator;
+	TheDebuginator* thed = &debuginator;
+	headless_create(thed, memory_arena, memory_arena_capacity, HEADLESS_LINE_HEIGHT, FRAMEBUFFER_HEIGHT);
+
+	char path[64];
+	for (int i = 0; i < 1000; i++) {
+		snprintf(path, sizeof(path), "Bench/Group %02d/Item %03d", i / 50, i);
+		debuginator_create_bool_item(thed, path, "Change a bool.", &g_testdata.bools[i % 8]);
+	}
+
+	debuginator_set_hot_item(thed, "Bench/Group 10/Item 500");
+	debuginator_set_open(thed, true);
+	headless_settle(thed);
+
+	const int frames = 1000;
+	double raster_ms = headless_bench_ms_per_frame(thed, frames);
+
+	// Without rasterization, only what the library itself costs
+	static DebuginatorDrawCommand commands[4096];
+	static char string_pool[64 * 1024];
+	DebuginatorDrawCommandBuffer command_buffer;
+	memset(&command_buffer, 0, sizeof(command_buffer));
+	command_buffer.commands = commands;
+	command_buffer.command_capacity = 4096;
+	command_buffer.string_pool = string_pool;
+	command_buffer.string_pool_capacity = sizeof(string_pool);
+	debuginator_set_draw_command_buffer(thed, &command_buffer);
+	double library_ms = headless_bench_ms_per_frame(thed, frames);
+	int command_count = command_buffer.command_count;
+	debuginator_set_draw_command_buffer(thed, NULL);
+
+	printf("Bench, 1000 items, %d rows visible:\n", FRAMEBUFFER_HEIGHT / HEADLESS_LINE_HEIGHT);
+	printf("  draw + raster:     %.4f ms/frame\n", raster_ms);
+	printf("  draw to commands:  %.4f ms/frame (%d commands)\n", library_ms, command_count);
+
+	free(memory_arena);
+}
+
+int main(int argc, char **argv)
+{
+	memset(&g_testdata, 0, sizeof(g_testdata));
+	bool run_bench = true;
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--update") == 0) {
+			g_testdata.update_goldens = true;
+		}
+		else if (strcmp(argv[i], "--no-bench") == 0) {
+			run_bench = false;
+		}
+	}
+
+	headless_run_goldens();
+	if (g_testdata.update_goldens) {
+		return 0;
+	}
+
+	printf("Golden errors found: %d/%d\n", g_testdata.error_count, g_testdata.golden_count);
+	if (g_testdata.assert_count > 0) {
+		printf("Debuginator asserts failed: %d\n", g_testdata.assert_count);
+		g_testdata.error_count += g_testdata.assert_count;
+	}
+
+	if (run_bench) {
+		headless_run_bench();
+	}
+
+	if (g_testdata.error_count == 0) {
+		printf("No errors found, YAY!\n");
+	}
+
+	return g_testdata.error_count == 0 ? 0 : 1;
+}
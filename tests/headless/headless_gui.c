@@ -0,0 +1,272 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "headless_gui.h"
+
+// Printable ASCII, one byte per row, bit 4 is the leftmost pixel.
+static const unsigned char s_font[95][7] = {
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // space
+	{ 0x04, 0x04, 0x04, 0x04, 0x04, 0x00, 0x04 }, // !
+	{ 0x0a, 0x0a, 0x0a, 0x00, 0x00, 0x00, 0x00 }, // "
+	{ 0x0a, 0x0a, 0x1f, 0x0a, 0x1f, 0x0a, 0x0a }, // #
+	{ 0x04, 0x0f, 0x14, 0x0e, 0x05, 0x1e, 0x04 }, // $
+	{ 0x18, 0x19, 0x02, 0x04, 0x08, 0x13, 0x03 }, // %
+	{ 0x0c, 0x12, 0x14, 0x08, 0x15, 0x12, 0x0d }, // &
+	{ 0x04, 0x04, 0x08, 0x00, 0x00, 0x00, 0x00 }, // '
+	{ 0x02, 0x04, 0x08, 0x08, 0x08, 0x04, 0x02 }, // (
+	{ 0x08, 0x04, 0x02, 0x02, 0x02, 0x04, 0x08 }, // )
+	{ 0x00, 0x04, 0x15, 0x0e, 0x15, 0x04, 0x00 }, // *
+	{ 0x00, 0x04, 0x04, 0x1f, 0x04, 0x04, 0x00 }, // +
+	{ 0x00, 0x00, 0x00, 0x00, 0x0c, 0x04, 0x08 }, // ,
+	{ 0x00, 0x00, 0x00, 0x1f, 0x00, 0x00, 0x00 }, // -
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x0c, 0x0c }, // .
+	{ 0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x00 }, // /
+	{ 0x0e, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0e }, // 0
+	{ 0x04, 0x0c, 0x04, 0x04, 0x04, 0x04, 0x0e }, // 1
+	{ 0x0e, 0x11, 0x01, 0x02, 0x04, 0x08, 0x1f }, // 2
+	{ 0x1f, 0x02, 0x04, 0x02, 0x01, 0x11, 0x0e }, // 3
+	{ 0x02, 0x06, 0x0a, 0x12, 0x1f, 0x02, 0x02 }, // 4
+	{ 0x1f, 0x10, 0x1e, 0x01, 0x01, 0x11, 0x0e }, // 5
+	{ 0x06, 0x08, 0x10, 0x1e, 0x11, 0x11, 0x0e }, // 6
+	{ 0x1f, 0x01, 0x02, 0x04, 0x08, 0x08, 0x08 }, // 7
+	{ 0x0e, 0x11, 0x11, 0x0e, 0x11, 0x11, 0x0e }, // 8
+	{ 0x0e, 0x11, 0x11, 0x0f, 0x01, 0x02, 0x0c }, // 9
+	{ 0x00, 0x0c, 0x0c, 0x00, 0x0c, 0x0c, 0x00 }, // :
+	{ 0x00, 0x0c, 0x0c, 0x00, 0x0c, 0x04, 0x08 }, // ;
+	{ 0x02, 0x04, 0x08, 0x10, 0x08, 0x04, 0x02 }, // <
+	{ 0x00, 0x00, 0x1f, 0x00, 0x1f, 0x00, 0x00 }, // =
+	{ 0x08, 0x04, 0x02, 0x01, 0x02, 0x04, 0x08 }, // >
+	{ 0x0e, 0x11, 0x01, 0x02, 0x04, 0x00, 0x04 }, // ?
+	{ 0x0e, 0x11, 0x01, 0x0d, 0x15, 0x15, 0x0e }, // @
+	{ 0x0e, 0x11, 0x11, 0x1f, 0x11, 0x11, 0x11 }, // A
+	{ 0x1e, 0x11, 0x11, 0x1e, 0x11, 0x11, 0x1e }, // B
+	{ 0x0e, 0x11, 0x10, 0x10, 0x10, 0x11, 0x0e }, // C
+	{ 0x1c, 0x12, 0x11, 0x11, 0x11, 0x12, 0x1c }, // D
+	{ 0x1f, 0x10, 0x10, 0x1e, 0x10, 0x10, 0x1f }, // E
+	{ 0x1f, 0x10, 0x10, 0x1e, 0x10, 0x10, 0x10 }, // F
+	{ 0x0e, 0x11, 0x10, 0x17, 0x11, 0x11, 0x0f }, // G
+	{ 0x11, 0x11, 0x11, 0x1f, 0x11, 0x11, 0x11 }, // H
+	{ 0x0e, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0e }, // I
+	{ 0x07, 0x02, 0x02, 0x02, 0x02, 0x12, 0x0c }, // J
+	{ 0x11, 0x12, 0x14, 0x18, 0x14, 0x12, 0x11 }, // K
+	{ 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x1f }, // L
+	{ 0x11, 0x1b, 0x15, 0x15, 0x11, 0x11, 0x11 }, // M
+	{ 0x11, 0x11, 0x19, 0x15, 0x13, 0x11, 0x11 }, // N
+	{ 0x0e, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0e }, // O
+	{ 0x1e, 0x11, 0x11, 0x1e, 0x10, 0x10, 0x10 }, // P
+	{ 0x0e, 0x11, 0x11, 0x11, 0x15, 0x12, 0x0d }, // Q
+	{ 0x1e, 0x11, 0x11, 0x1e, 0x14, 0x12, 0x11 }, // R
+	{ 0x0f, 0x10, 0x10, 0x0e, 0x01, 0x01, 0x1e }, // S
+	{ 0x1f, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04 }, // T
+	{ 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0e }, // U
+	{ 0x11, 0x11, 0x11, 0x11, 0x11, 0x0a, 0x04 }, // V
+	{ 0x11, 0x11, 0x11, 0x15, 0x15, 0x15, 0x0a }, // W
+	{ 0x11, 0x11, 0x0a, 0x04, 0x0a, 0x11, 0x11 }, // X
+	{ 0x11, 0x11, 0x11, 0x0a, 0x04, 0x04, 0x04 }, // Y
+	{ 0x1f, 0x01, 0x02, 0x04, 0x08, 0x10, 0x1f }, // Z
+	{ 0x0e, 0x08, 0x08, 0x08, 0x08, 0x08, 0x0e }, // [
+	{ 0x00, 0x10, 0x08, 0x04, 0x02, 0x01, 0x00 }, // backslash
+	{ 0x0e, 0x02, 0x02, 0x02, 0x02, 0x02, 0x0e }, // ]
+	{ 0x04, 0x0a, 0x11, 0x00, 0x00, 0x00, 0x00 }, // ^
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1f }, // _
+	{ 0x08, 0x04, 0x02, 0x00, 0x00, 0x00, 0x00 }, // `
+	{ 0x00, 0x00, 0x0e, 0x01, 0x0f, 0x11, 0x0f }, // a
+	{ 0x10, 0x10, 0x16, 0x19, 0x11, 0x11, 0x1e }, // b
+	{ 0x00, 0x00, 0x0e, 0x10, 0x10, 0x11, 0x0e }, // c
+	{ 0x01, 0x01, 0x0d, 0x13, 0x11, 0x11, 0x0f }, // d
+	{ 0x00, 0x00, 0x0e, 0x11, 0x1f, 0x10, 0x0e }, // e
+	{ 0x06, 0x09, 0x08, 0x1c, 0x08, 0x08, 0x08 }, // f
+	{ 0x00, 0x0f, 0x11, 0x11, 0x0f, 0x01, 0x0e }, // g
+	{ 0x10, 0x10, 0x16, 0x19, 0x11, 0x11, 0x11 }, // h
+	{ 0x04, 0x00, 0x0c, 0x04, 0x04, 0x04, 0x0e }, // i
+	{ 0x02, 0x00, 0x06, 0x02, 0x02, 0x12, 0x0c }, // j
+	{ 0x10, 0x10, 0x12, 0x14, 0x18, 0x14, 0x12 }, // k
+	{ 0x0c, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0e }, // l
+	{ 0x00, 0x00, 0x1a, 0x15, 0x15, 0x11, 0x11 }, // m
+	{ 0x00, 0x00, 0x16, 0x19, 0x11, 0x11, 0x11 }, // n
+	{ 0x00, 0x00, 0x0e, 0x11, 0x11, 0x11, 0x0e }, // o
+	{ 0x00, 0x00, 0x1e, 0x11, 0x1e, 0x10, 0x10 }, // p
+	{ 0x00, 0x00, 0x0d, 0x13, 0x0f, 0x01, 0x01 }, // q
+	{ 0x00, 0x00, 0x16, 0x19, 0x10, 0x10, 0x10 }, // r
+	{ 0x00, 0x00, 0x0e, 0x10, 0x0e, 0x01, 0x1e }, // s
+	{ 0x08, 0x08, 0x1c, 0x08, 0x08, 0x09, 0x06 }, // t
+	{ 0x00, 0x00, 0x11, 0x11, 0x11, 0x13, 0x0d }, // u
+	{ 0x00, 0x00, 0x11, 0x11, 0x11, 0x0a, 0x04 }, // v
+	{ 0x00, 0x00, 0x11, 0x11, 0x15, 0x15, 0x0a }, // w
+	{ 0x00, 0x00, 0x11, 0x0a, 0x04, 0x0a, 0x11 }, // x
+	{ 0x00, 0x00, 0x11, 0x11, 0x0f, 0x01, 0x0e }, // y
+	{ 0x00, 0x00, 0x1f, 0x02, 0x04, 0x08, 0x1f }, // z
+	{ 0x02, 0x04, 0x04, 0x08, 0x04, 0x04, 0x02 }, // {
+	{ 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04 }, // |
+	{ 0x08, 0x04, 0x04, 0x02, 0x04, 0x04, 0x08 }, // }
+	{ 0x00, 0x00, 0x08, 0x15, 0x02, 0x00, 0x00 }, // ~
+
+};
+
+static void headless__blend(uint32_t* pixel, DebuginatorColor* color) {
+	unsigned alpha = color->a;
+	if (alpha == 0) {
+		return;
+	}
+
+	uint32_t destination = *pixel;
+	unsigned r = (color->r * alpha + ((destination >> 16) & 0xff) * (255 - alpha) + 127) / 255;
+	unsigned g = (color->g * alpha + ((destination >> 8) & 0xff) * (255 - alpha) + 127) / 255;
+	unsigned b = (color->b * alpha + (destination & 0xff) * (255 - alpha) + 127) / 255;
+	*pixel = 0xff000000u | (r << 16) | (g << 8) | b;
+}
+
+// Clips [x0, x1) x [y0, y1) to the framebuffer, returns false if nothing is left.
+static bool headless__clip(const HeadlessFramebuffer* framebuffer, int* x0, int* y0, int* x1, int* y1) {
+	*x0 = *x0 < 0 ? 0 : *x0;
+	*y0 = *y0 < 0 ? 0 : *y0;
+	*x1 = *x1 > framebuffer->width ? framebuffer->width : *x1;
+	*y1 = *y1 > framebuffer->height ? framebuffer->height : *y1;
+	return *x0 < *x1 && *y0 < *y1;
+}
+
+void headless_clear(HeadlessFramebuffer* framebuffer, uint32_t color) {
+	for (int i = 0; i < framebuffer->width * framebuffer->height; i++) {
+		framebuffer->pixels[i] = color;
+	}
+}
+
+// 64 bit FNV-1a over the pixels, independent of endianness.
+uint64_t headless_hash(const HeadlessFramebuffer* framebuffer) {
+	uint64_t hash = 0xcbf29ce484222325ull;
+	for (int i = 0; i < framebuffer->width * framebuffer->height; i++) {
+		uint32_t pixel = framebuffer->pixels[i];
+		for (int byte = 0; byte < 4; byte++) {
+			hash ^= (pixel >> (byte * 8)) & 0xff;
+			hash *= 0x100000001b3ull;
+		}
+	}
+
+	return hash;
+}
+
+bool headless_write_ppm(const HeadlessFramebuffer* framebuffer, const char* path) {
+	FILE* file = fopen(path, "wb");
+	if (file == NULL) {
+		return false;
+	}
+
+	fprintf(file, "P6\n%d %d\n255\n", framebuffer->width, framebuffer->height);
+	for (int i = 0; i < framebuffer->width * framebuffer->height; i++) {
+		uint32_t pixel = framebuffer->pixels[i];
+		unsigned char rgb[3] = { (unsigned char)(pixel >> 16), (unsigned char)(pixel >> 8), (unsigned char)pixel };
+		fwrite(rgb, 1, 3, file);
+	}
+
+	fclose(file);
+	return true;
+}
+
+void headless_draw_rect(DebuginatorVector2* position, DebuginatorVector2* size, DebuginatorColor* color, void* userdata) {
+	HeadlessFramebuffer* framebuffer = (HeadlessFramebuffer*)userdata;
+	int x0 = (int)position->x;
+	int y0 = (int)position->y;
+	int x1 = x0 + (int)size->x;
+	int y1 = y0 + (int)size->y;
+	if (!headless__clip(framebuffer, &x0, &y0, &x1, &y1)) {
+		return;
+	}
+
+	for (int y = y0; y < y1; y++) {
+		uint32_t* row = framebuffer->pixels + y * framebuffer->width;
+		for (int x = x0; x < x1; x++) {
+			headless__blend(&row[x], color);
+		}
+	}
+}
+
+void headless_draw_text(const char* text, DebuginatorVector2* position, DebuginatorColor* color, DebuginatorFont* font, void* userdata) {
+	HeadlessFramebuffer* framebuffer = (HeadlessFramebuffer*)userdata;
+	int pen_x = (int)position->x;
+	int pen_y = (int)position->y + HEADLESS_GLYPH_SCALE;
+	for (const char* c = text; *c != '\0'; c++, pen_x += HEADLESS_GLYPH_ADVANCE) {
+		if (pen_x >= framebuffer->width) {
+			break;
+		}
+
+		int glyph_index = (unsigned char)*c - 32;
+		if (glyph_index < 0 || glyph_index >= 95) {
+			glyph_index = '?' - 32;
+		}
+
+		const unsigned char* glyph = s_font[glyph_index];
+		for (int row = 0; row < 7; row++) {
+			// Italic shears the top rows to the right
+			int shear = font->italic ? (6 - row) / 3 * HEADLESS_GLYPH_SCALE / 2 : 0;
+			for (int column = 0; column < 5; column++) {
+				bool set = (glyph[row] >> (4 - column)) & 1;
+				if (font->bold && column > 0) {
+					set = set || ((glyph[row] >> (5 - column)) & 1);
+				}
+
+				if (!set) {
+					continue;
+				}
+
+				int x0 = pen_x + column * HEADLESS_GLYPH_SCALE + shear;
+				int y0 = pen_y + row * HEADLESS_GLYPH_SCALE;
+				int x1 = x0 + HEADLESS_GLYPH_SCALE;
+				int y1 = y0 + HEADLESS_GLYPH_SCALE;
+				if (!headless__clip(framebuffer, &x0, &y0, &x1, &y1)) {
+					continue;
+				}
+
+				for (int y = y0; y < y1; y++) {
+					for (int x = x0; x < x1; x++) {
+						headless__blend(&framebuffer->pixels[y * framebuffer->width + x], color);
+					}
+				}
+			}
+		}
+	}
+}
+
+// Same row semantics as the SDL demo: a row ends before the word that didn't fit, and
+// newlines end a row without being part of it.
+void headless_word_wrap(const char* text, DebuginatorFont font, float max_width, unsigned* row_count, unsigned* row_lengths, unsigned row_lengths_buffer_size, void* app_userdata) {
+	(void)font;
+	(void)app_userdata;
+	int max_chars = (int)(max_width / HEADLESS_GLYPH_ADVANCE);
+	if (max_chars < 1) {
+		max_chars = 1;
+	}
+
+	*row_count = 0;
+	const char* row_start = text;
+	while (*row_start != '\0' && *row_count < row_lengths_buffer_size) {
+		const char* c = row_start;
+		const char* last_break = NULL;
+		while (*c != '\0' && *c != '\n' && c - row_start < max_chars) {
+			if (*c == ' ') {
+				last_break = c + 1;
+			}
+
+			++c;
+		}
+
+		const char* row_end = c;
+		if (*c != '\0' && *c != '\n' && last_break != NULL) {
+			row_end = last_break;
+		}
+
+		row_lengths[(*row_count)++] = (unsigned)(row_end - row_start);
+		row_start = row_end;
+		while (*row_start == '\n') {
+			++row_start;
+		}
+	}
+}
+
+DebuginatorVector2 headless_text_size(const char* text, DebuginatorFont* font, void* userdata) {
+	(void)font;
+	(void)userdata;
+	DebuginatorVector2 size;
+	size.x = (float)(strlen(text) * HEADLESS_GLYPH_ADVANCE);
+	size.y = (float)HEADLESS_LINE_HEIGHT;
+	return size;
+}
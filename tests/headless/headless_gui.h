@@ -0,0 +1,43 @@
+#pragma once
+
+// CPU framebuffer backend for The Debuginator.
+// Needs no window, GPU or fonts on disk, so it runs anywhere - golden image tests and
+// draw path benchmarks on build machines. Text uses a built-in 5x7 bitmap font.
+
+#include <stdint.h>
+
+#ifndef __cplusplus
+#include <stdbool.h>
+#endif
+
+#include "../../the_debuginator.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct HeadlessFramebuffer {
+	uint32_t* pixels; // 0xAARRGGBB, owned by the application
+	int width;
+	int height;
+} HeadlessFramebuffer;
+
+#define HEADLESS_GLYPH_SCALE 2
+#define HEADLESS_GLYPH_WIDTH (5 * HEADLESS_GLYPH_SCALE)
+#define HEADLESS_GLYPH_HEIGHT (7 * HEADLESS_GLYPH_SCALE)
+#define HEADLESS_GLYPH_ADVANCE (HEADLESS_GLYPH_WIDTH + HEADLESS_GLYPH_SCALE)
+#define HEADLESS_LINE_HEIGHT (HEADLESS_GLYPH_HEIGHT + 2 * HEADLESS_GLYPH_SCALE)
+
+void headless_clear(HeadlessFramebuffer* framebuffer, uint32_t color);
+uint64_t headless_hash(const HeadlessFramebuffer* framebuffer);
+bool headless_write_ppm(const HeadlessFramebuffer* framebuffer, const char* path);
+
+// Debuginator callbacks, app_user_data should be the HeadlessFramebuffer.
+void headless_draw_text(const char* text, DebuginatorVector2* position, DebuginatorColor* color, DebuginatorFont* font, void* userdata);
+void headless_draw_rect(DebuginatorVector2* position, DebuginatorVector2* size, DebuginatorColor* color, void* userdata);
+void headless_word_wrap(const char* text, DebuginatorFont font, float max_width, unsigned* row_count, unsigned* row_lengths, unsigned row_lengths_buffer_size, void* app_userdata);
+DebuginatorVector2 headless_text_size(const char* text, DebuginatorFont* font, void* userdata);
+
+#ifdef __cplusplus
+}
+#endif
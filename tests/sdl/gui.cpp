@@ -5,10 +5,73 @@
 
 #include "gui.h"
 
+#define GLYPH_FIRST 32
+#define GLYPH_COUNT 95 // Printable ASCII
+
+struct GlyphInfo {
+	SDL_Rect rect; // In the atlas, w == 0 if the glyph has no pixels
+	int advance;
+};
+
 struct FontTemplate {
 	TTF_Font* font;
 	//const char* font;
 	//int size;
+
+	GlyphInfo glyphs[GLYPH_COUNT];
+};
+
+#define TEXT_CACHE_MAX_ENTRIES 1024
+#define TEXT_CACHE_BUCKET_COUNT 2048 // Power of two
+#define TEXT_CACHE_DEFAULT_BUDGET (8 * 1024 * 1024)
+
+// Textures are rendered at full opacity, alpha is applied with SDL_SetTextureAlphaMod
+// so fading the menu in and out doesn't create new textures.
+struct TextCacheEntry {
+	Uint64 text_hash;
+	int text_length;
+	FontTemplate* font_template;
+	Uint8 r, g, b;
+
+	SDL_Texture* texture;
+	int width;
+	int height;
+	size_t bytes;
+
+	int lru_prev; // Towards most recently used
+	int lru_next;
+	int bucket_next; // Also used for the free list
+};
+
+struct TextCache {
+	TextCacheEntry entries[TEXT_CACHE_MAX_ENTRIES];
+	int buckets[TEXT_CACHE_BUCKET_COUNT];
+	int free_list;
+	int lru_head;
+	int lru_tail;
+	size_t bytes_used;
+	size_t byte_budget;
+	GuiTextCacheStats stats;
+};
+
+#define ATLAS_SIZE 1024
+#define BATCH_MAX_QUADS 8192
+
+// The atlas is drawn with SDL_RenderGeometry, which needs SDL 2.0.18. With older versions
+// gui_set_text_mode falls back to the text cache.
+#define GUI_HAS_GLYPH_ATLAS SDL_VERSION_ATLEAST(2, 0, 18)
+
+// Glyphs of all registered fonts are rendered in white into a single atlas, along with a
+// white texel for rects, so a frame's worth of text and rects can be a single draw call.
+struct GlyphAtlas {
+	SDL_Texture* texture;
+	bool dirty;
+
+#if GUI_HAS_GLYPH_ATLAS
+	SDL_Vertex vertices[BATCH_MAX_QUADS * 4];
+	int indices[BATCH_MAX_QUADS * 6];
+#endif
+	int quad_count;
 };
 
 struct Gui {
@@ -17,11 +80,353 @@ struct Gui {
 
 	FontTemplate font_templates[8];
 	int font_template_count;
+
+	GuiTextMode text_mode;
+	TextCache text_cache;
+	GlyphAtlas atlas;
 };
 
 static Gui guis[1];
 static int gui_count = 0;
 
+static Uint64 text_cache_hash_text(const char* text, int* out_length) {
+	Uint64 hash = 0xcbf29ce484222325ull;
+	const char* c = text;
+	for (; *c != '\0'; c++) {
+		hash ^= (unsigned char)*c;
+		hash *= 0x100000001b3ull;
+	}
+
+	*out_length = (int)(c - text);
+	return hash;
+}
+
+static int text_cache_bucket(Uint64 text_hash, FontTemplate* font_template, Color color) {
+	Uint64 hash = text_hash ^ ((Uint64)(uintptr_t)font_template * 0x9E3779B97F4A7C15ull);
+	hash ^= ((Uint64)color.r << 16 | (Uint64)color.g << 8 | color.b) * 0xff51afd7ed558ccdull;
+	hash ^= hash >> 32;
+	return (int)(hash & (TEXT_CACHE_BUCKET_COUNT - 1));
+}
+
+static void text_cache_init(TextCache* cache) {
+	for (int i = 0; i < TEXT_CACHE_BUCKET_COUNT; i++) {
+		cache->buckets[i] = -1;
+	}
+
+	for (int i = 0; i < TEXT_CACHE_MAX_ENTRIES; i++) {
+		cache->entries[i].bucket_next = i + 1 < TEXT_CACHE_MAX_ENTRIES ? i + 1 : -1;
+	}
+
+	cache->free_list = 0;
+	cache->lru_head = -1;
+	cache->lru_tail = -1;
+	cache->bytes_used = 0;
+	cache->byte_budget = TEXT_CACHE_DEFAULT_BUDGET;
+}
+
+static void text_cache_lru_unlink(TextCache* cache, int index) {
+	TextCacheEntry* entry = &cache->entries[index];
+	if (entry->lru_prev != -1) {
+		cache->entries[entry->lru_prev].lru_next = entry->lru_next;
+	}
+	else {
+		cache->lru_head = entry->lru_next;
+	}
+
+	if (entry->lru_next != -1) {
+		cache->entries[entry->lru_next].lru_prev = entry->lru_prev;
+	}
+	else {
+		cache->lru_tail = entry->lru_prev;
+	}
+}
+
+static void text_cache_lru_push_front(TextCache* cache, int index) {
+	TextCacheEntry* entry = &cache->entries[index];
+	entry->lru_prev = -1;
+	entry->lru_next = cache->lru_head;
+	if (cache->lru_head != -1) {
+		cache->entries[cache->lru_head].lru_prev = index;
+	}
+	else {
+		cache->lru_tail = index;
+	}
+
+	cache->lru_head = index;
+}
+
+static void text_cache_remove(TextCache* cache, int index) {
+	TextCacheEntry* entry = &cache->entries[index];
+	int bucket = text_cache_bucket(entry->text_hash, entry->font_template, Color(entry->r, entry->g, entry->b, 255));
+	int* link = &cache->buckets[bucket];
+	while (*link != index) {
+		link = &cache->entries[*link].bucket_next;
+	}
+
+	*link = entry->bucket_next;
+	text_cache_lru_unlink(cache, index);
+
+	SDL_DestroyTexture(entry->texture);
+	entry->texture = NULL;
+	cache->bytes_used -= entry->bytes;
+	cache->stats.entry_count--;
+
+	entry->bucket_next = cache->free_list;
+	cache->free_list = index;
+}
+
+static void text_cache_evict_to_fit(TextCache* cache, size_t wanted_bytes, bool wants_entry) {
+	while (cache->lru_tail != -1 && (cache->bytes_used + wanted_bytes > cache->byte_budget || (wants_entry && cache->free_list == -1))) {
+		text_cache_remove(cache, cache->lru_tail);
+		cache->stats.evictions++;
+	}
+}
+
+static void text_cache_clear(TextCache* cache, FontTemplate* font_template) {
+	int index = cache->lru_head;
+	while (index != -1) {
+		int next = cache->entries[index].lru_next;
+		if (font_template == NULL || cache->entries[index].font_template == font_template) {
+			text_cache_remove(cache, index);
+		}
+
+		index = next;
+	}
+}
+
+static SDL_Texture* text_cache_render(SDL_Renderer* renderer, FontTemplate* font_template, const char* text, Color color, int* out_width, int* out_height) {
+	SDL_Color text_color = { color.r, color.g, color.b, 255 };
+	SDL_Surface* text_surface = TTF_RenderText_Blended(font_template->font, text, text_color);
+	if (text_surface == NULL) {
+		return NULL;
+	}
+
+	SDL_Texture* text_texture = SDL_CreateTextureFromSurface(renderer, text_surface);
+	*out_width = text_surface->w;
+	*out_height = text_surface->h;
+	SDL_FreeSurface(text_surface);
+	return text_texture;
+}
+
+// Returns the cached texture, rendering and inserting it on a miss. If the texture doesn't
+// fit in the budget at all, it's returned with out_owned set and the caller destroys it.
+static SDL_Texture* text_cache_get(Gui* gui, FontTemplate* font_template, const char* text, Color color, int* out_width, int* out_height, bool* out_owned) {
+	TextCache* cache = &gui->text_cache;
+	*out_owned = false;
+
+	int text_length = 0;
+	Uint64 text_hash = text_cache_hash_text(text, &text_length);
+	int bucket = text_cache_bucket(text_hash, font_template, color);
+	for (int index = cache->buckets[bucket]; index != -1; index = cache->entries[index].bucket_next) {
+		TextCacheEntry* entry = &cache->entries[index];
+		if (entry->text_hash == text_hash && entry->text_length == text_length && entry->font_template == font_template
+			&& entry->r == color.r && entry->g == color.g && entry->b == color.b) {
+			text_cache_lru_unlink(cache, index);
+			text_cache_lru_push_front(cache, index);
+			cache->stats.hits++;
+			cache->stats.frame_hits++;
+			*out_width = entry->width;
+			*out_height = entry->height;
+			return entry->texture;
+		}
+	}
+
+	cache->stats.misses++;
+	cache->stats.frame_misses++;
+
+	int width, height;
+	SDL_Texture* texture = text_cache_render(gui->renderer, font_template, text, color, &width, &height);
+	if (texture == NULL) {
+		return NULL;
+	}
+
+	*out_width = width;
+	*out_height = height;
+
+	size_t bytes = (size_t)width * (size_t)height * 4;
+	if (bytes > cache->byte_budget) {
+		*out_owned = true;
+		return texture;
+	}
+
+	text_cache_evict_to_fit(cache, bytes, true);
+
+	int index = cache->free_list;
+	TextCacheEntry* entry = &cache->entries[index];
+	cache->free_list = entry->bucket_next;
+
+	entry->text_hash = text_hash;
+	entry->text_length = text_length;
+	entry->font_template = font_template;
+	entry->r = color.r;
+	entry->g = color.g;
+	entry->b = color.b;
+	entry->texture = texture;
+	entry->width = width;
+	entry->height = height;
+	entry->bytes = bytes;
+	entry->bucket_next = cache->buckets[bucket];
+	cache->buckets[bucket] = index;
+	text_cache_lru_push_front(cache, index);
+
+	cache->bytes_used += bytes;
+	cache->stats.entry_count++;
+	return texture;
+}
+
+#if GUI_HAS_GLYPH_ATLAS
+static bool atlas_build(Gui* gui) {
+	GlyphAtlas* atlas = &gui->atlas;
+	if (atlas->texture != NULL) {
+		SDL_DestroyTexture(atlas->texture);
+		atlas->texture = NULL;
+	}
+
+	SDL_Surface* atlas_surface = SDL_CreateRGBSurfaceWithFormat(0, ATLAS_SIZE, ATLAS_SIZE, 32, SDL_PIXELFORMAT_RGBA32);
+	if (atlas_surface == NULL) {
+		return false;
+	}
+
+	SDL_FillRect(atlas_surface, NULL, SDL_MapRGBA(atlas_surface->format, 255, 255, 255, 0));
+	SDL_Rect white_rect = { 0, 0, 2, 2 };
+	SDL_FillRect(atlas_surface, &white_rect, SDL_MapRGBA(atlas_surface->format, 255, 255, 255, 255));
+
+	// Simple shelf packing, one pixel of padding between glyphs
+	int x = white_rect.w + 1;
+	int y = 0;
+	int row_height = white_rect.h;
+	SDL_Color white = { 255, 255, 255, 255 };
+	for (int font_i = 0; font_i < gui->font_template_count; font_i++) {
+		FontTemplate* font_template = &gui->font_templates[font_i];
+		if (font_template->font == NULL) {
+			continue;
+		}
+
+		for (int glyph_i = 0; glyph_i < GLYPH_COUNT; glyph_i++) {
+			GlyphInfo* glyph = &font_template->glyphs[glyph_i];
+			Uint16 character = (Uint16)(GLYPH_FIRST + glyph_i);
+			glyph->advance = 0;
+			TTF_GlyphMetrics(font_template->font, character, NULL, NULL, NULL, NULL, &glyph->advance);
+			SDL_memset(&glyph->rect, 0, sizeof(glyph->rect));
+
+			SDL_Surface* glyph_surface = TTF_RenderGlyph_Blended(font_template->font, character, white);
+			if (glyph_surface == NULL) {
+				continue;
+			}
+
+			if (x + glyph_surface->w > ATLAS_SIZE) {
+				x = 0;
+				y += row_height + 1;
+				row_height = 0;
+			}
+
+			if (y + glyph_surface->h > ATLAS_SIZE) {
+				SDL_FreeSurface(glyph_surface);
+				SDL_FreeSurface(atlas_surface);
+				return false;
+			}
+
+			SDL_Rect destination = { x, y, glyph_surface->w, glyph_surface->h };
+			SDL_SetSurfaceBlendMode(glyph_surface, SDL_BLENDMODE_NONE);
+			SDL_BlitSurface(glyph_surface, NULL, atlas_surface, &destination);
+			glyph->rect = destination;
+
+			x += glyph_surface->w + 1;
+			row_height = glyph_surface->h > row_height ? glyph_surface->h : row_height;
+			SDL_FreeSurface(glyph_surface);
+		}
+	}
+
+	atlas->texture = SDL_CreateTextureFromSurface(gui->renderer, atlas_surface);
+	SDL_FreeSurface(atlas_surface);
+	if (atlas->texture == NULL) {
+		return false;
+	}
+
+	SDL_SetTextureBlendMode(atlas->texture, SDL_BLENDMODE_BLEND);
+	atlas->dirty = false;
+	return true;
+}
+
+static void atlas_flush(Gui* gui) {
+	GlyphAtlas* atlas = &gui->atlas;
+	if (atlas->quad_count == 0) {
+		return;
+	}
+
+	SDL_RenderGeometry(gui->renderer, atlas->texture, atlas->vertices, atlas->quad_count * 4, atlas->indices, atlas->quad_count * 6);
+	atlas->quad_count = 0;
+}
+
+static void atlas_push_quad(Gui* gui, float x, float y, float w, float h, const SDL_Rect* source, Color color) {
+	GlyphAtlas* atlas = &gui->atlas;
+	if (atlas->quad_count == BATCH_MAX_QUADS) {
+		atlas_flush(gui);
+	}
+
+	float u0 = source->x / (float)ATLAS_SIZE;
+	float v0 = source->y / (float)ATLAS_SIZE;
+	float u1 = (source->x + source->w) / (float)ATLAS_SIZE;
+	float v1 = (source->y + source->h) / (float)ATLAS_SIZE;
+	SDL_Color vertex_color = { color.r, color.g, color.b, color.a };
+
+	int first_vertex = atlas->quad_count * 4;
+	SDL_Vertex* vertices = &atlas->vertices[first_vertex];
+	vertices[0].position.x = x;     vertices[0].position.y = y;     vertices[0].tex_coord.x = u0; vertices[0].tex_coord.y = v0;
+	vertices[1].position.x = x + w; vertices[1].position.y = y;     vertices[1].tex_coord.x = u1; vertices[1].tex_coord.y = v0;
+	vertices[2].position.x = x + w; vertices[2].position.y = y + h; vertices[2].tex_coord.x = u1; vertices[2].tex_coord.y = v1;
+	vertices[3].position.x = x;     vertices[3].position.y = y + h; vertices[3].tex_coord.x = u0; vertices[3].tex_coord.y = v1;
+	for (int i = 0; i < 4; i++) {
+		vertices[i].color = vertex_color;
+	}
+
+	int* indices = &atlas->indices[atlas->quad_count * 6];
+	indices[0] = first_vertex + 0;
+	indices[1] = first_vertex + 1;
+	indices[2] = first_vertex + 2;
+	indices[3] = first_vertex + 0;
+	indices[4] = first_vertex + 2;
+	indices[5] = first_vertex + 3;
+	atlas->quad_count++;
+}
+
+static void atlas_draw_text(Gui* gui, FontTemplate* font_template, const char* text, Vector2 position, Color color) {
+	// Snapped to whole pixels like the per string path. No kerning, which TTF_SizeText
+	// doesn't apply for these fonts either.
+	float pen_x = (float)(int)position.x;
+	float pen_y = (float)(int)position.y;
+	for (const char* c = text; *c != '\0'; c++) {
+		int glyph_index = (unsigned char)*c - GLYPH_FIRST;
+		if (glyph_index < 0 || glyph_index >= GLYPH_COUNT) {
+			glyph_index = '?' - GLYPH_FIRST;
+		}
+
+		GlyphInfo* glyph = &font_template->glyphs[glyph_index];
+		if (glyph->rect.w > 0) {
+			atlas_push_quad(gui, pen_x, pen_y, (float)glyph->rect.w, (float)glyph->rect.h, &glyph->rect, color);
+		}
+
+		pen_x += glyph->advance;
+	}
+}
+#else
+static bool atlas_build(Gui* gui) {
+	(void)gui;
+	return false;
+}
+
+static void atlas_flush(Gui* gui) {
+	(void)gui;
+}
+
+static void atlas_push_quad(Gui* gui, float x, float y, float w, float h, const SDL_Rect* source, Color color) {
+	(void)gui, (void)x, (void)y, (void)w, (void)h, (void)source, (void)color;
+}
+
+static void atlas_draw_text(Gui* gui, FontTemplate* font_template, const char* text, Vector2 position, Color color) {
+	(void)gui, (void)font_template, (void)text, (void)position, (void)color;
+}
+#endif
 
 GuiHandle gui_create_gui(int resx, int resy, const char* window_title, bool vsync_on) {
 	if (gui_count > 0) {
@@ -57,6 +462,7 @@ GuiHandle gui_create_gui(int resx, int resy, const char* window_title, bool vsyn
 	SDL_memset(gui, 0, sizeof(*gui));
 	gui->renderer = renderer;
 	gui->window = window;
+	text_cache_init(&gui->text_cache);
 
 	return (GuiHandle)gui;
 }
@@ -64,18 +470,26 @@ GuiHandle gui_create_gui(int resx, int resy, const char* window_title, bool vsyn
 void gui_destroy_gui(GuiHandle gui_handle) {
 	Gui* gui = (Gui*)gui_handle;
 
+	text_cache_clear(&gui->text_cache, NULL);
+	if (gui->atlas.texture != NULL) {
+		SDL_DestroyTexture(gui->atlas.texture);
+	}
+
 	SDL_DestroyWindow(gui->window);
 	SDL_Quit();
 }
 
 void gui_frame_begin(GuiHandle gui_handle) {
 	Gui* gui = (Gui*)gui_handle;
+	gui->text_cache.stats.frame_hits = 0;
+	gui->text_cache.stats.frame_misses = 0;
 	SDL_SetRenderDrawColor(gui->renderer, 0, 0, 0, 255);
 	SDL_RenderClear(gui->renderer);
 }
 
 void gui_frame_end(GuiHandle gui_handle){
 	Gui* gui = (Gui*)gui_handle;
+	atlas_flush(gui);
 	SDL_RenderPresent(gui->renderer);
 }
 
@@ -88,48 +502,65 @@ FontTemplateHandle gui_register_font_template(GuiHandle gui_handle, const char*
 	Gui* gui = (Gui*)gui_handle;
 	FontTemplate* font_template = &gui->font_templates[gui->font_template_count++];
 	font_template->font = ttf_font;
+	gui->atlas.dirty = true;
 
 	return (FontTemplateHandle)font_template;
 }
 
 void gui_unregister_font_template(GuiHandle gui_handle, FontTemplateHandle font_handle) {
-	(void)gui_handle;
+	Gui* gui = (Gui*)gui_handle;
 	FontTemplate* font_template = (FontTemplate*)font_handle;
+	text_cache_clear(&gui->text_cache, font_template);
+	gui->atlas.dirty = true;
 	TTF_CloseFont(font_template->font);
 	font_template->font = 0;
 }
 
 void gui_draw_text(GuiHandle gui_handle, const char* text, Vector2 position, FontTemplateHandle font_handle, Color color) {
 	Gui* gui = (Gui*)gui_handle;
-	SDL_Color* text_color = (SDL_Color*)&color;
 	FontTemplate* font_template = (FontTemplate*)font_handle;
-	SDL_Surface* text_surface = TTF_RenderText_Blended(font_template->font, text, *text_color);
-	if (text_surface == NULL) {
-		// TODO Assert
+	if (text[0] == '\0' || color.a == 0) {
 		return;
 	}
 
-	SDL_Texture* text_texture = SDL_CreateTextureFromSurface(gui->renderer, text_surface);
+	if (gui->text_mode == GUI_TextModeGlyphAtlas && gui->atlas.dirty) {
+		// A font was registered after the atlas was built
+		gui_set_text_mode(gui_handle, GUI_TextModeGlyphAtlas);
+	}
+
+	if (gui->text_mode == GUI_TextModeGlyphAtlas) {
+		atlas_draw_text(gui, font_template, text, position, color);
+		return;
+	}
+
+	SDL_Rect rectangle;
+	bool texture_owned = false;
+	SDL_Texture* text_texture = text_cache_get(gui, font_template, text, color, &rectangle.w, &rectangle.h, &texture_owned);
 	if (text_texture == NULL) {
 		// TODO Assert
 		return;
 	}
 
-	SDL_FreeSurface(text_surface);
-
-	SDL_Rect rectangle;
 	rectangle.x = (int)position.x;
 	rectangle.y = (int)position.y;
-	TTF_SizeText(font_template->font, text, &rectangle.w, &rectangle.h);
-	
-	SDL_SetRenderDrawColor(gui->renderer, 255, 255, 255, 255);
+
+	SDL_SetTextureAlphaMod(text_texture, color.a);
 	SDL_RenderCopy(gui->renderer, text_texture, NULL, &rectangle);
 
-	SDL_DestroyTexture(text_texture);
+	if (texture_owned) {
+		SDL_DestroyTexture(text_texture);
+	}
 }
 
 void gui_draw_rect_filled(GuiHandle gui_handle, Vector2 position, Vector2 size, Color color) {
 	Gui* gui = (Gui*)gui_handle;
+	if (gui->text_mode == GUI_TextModeGlyphAtlas) {
+		// Rects go in the same batch to keep the draw order
+		SDL_Rect white_texel = { 0, 0, 1, 1 };
+		atlas_push_quad(gui, position.x, position.y, size.x, size.y, &white_texel, color);
+		return;
+	}
+
 	SDL_Rect rect;
 	rect.x = (int)position.x;
 	rect.y = (int)position.y;
@@ -232,3 +663,31 @@ Vector2 gui_text_size(GuiHandle gui_handle, const char* text, FontTemplateHandle
 	Vector2 out_text_size((float)x, (float)y);
 	return out_text_size;
 }
+
+void gui_set_text_cache_budget(GuiHandle gui_handle, size_t byte_budget) {
+	Gui* gui = (Gui*)gui_handle;
+	gui->text_cache.byte_budget = byte_budget;
+	text_cache_evict_to_fit(&gui->text_cache, 0, false);
+}
+
+GuiTextCacheStats gui_get_text_cache_stats(GuiHandle gui_handle) {
+	Gui* gui = (Gui*)gui_handle;
+	GuiTextCacheStats stats = gui->text_cache.stats;
+	stats.bytes_used = gui->text_cache.bytes_used;
+	stats.byte_budget = gui->text_cache.byte_budget;
+	return stats;
+}
+
+void gui_set_text_mode(GuiHandle gui_handle, GuiTextMode mode) {
+	Gui* gui = (Gui*)gui_handle;
+	if (mode == GUI_TextModeGlyphAtlas && (gui->atlas.dirty || gui->atlas.texture == NULL)) {
+		atlas_flush(gui);
+		if (!atlas_build(gui)) {
+			mode = GUI_TextModeCachedStrings;
+		}
+	}
+
+	// Whatever was batched so far needs to come before anything drawn in the new mode
+	atlas_flush(gui);
+	gui->text_mode = mode;
+}
@@ -27,6 +27,22 @@ struct Color {
 	unsigned char a;
 };
 
+enum GuiTextMode {
+	GUI_TextModeCachedStrings, // One texture per string, see the text cache
+	GUI_TextModeGlyphAtlas, // All text and rects batched into one draw call per frame, needs SDL 2.0.18
+};
+
+struct GuiTextCacheStats {
+	unsigned hits;
+	unsigned misses;
+	unsigned evictions;
+	unsigned frame_hits; // Since last gui_frame_begin
+	unsigned frame_misses;
+	int entry_count;
+	size_t bytes_used;
+	size_t byte_budget;
+};
+
 GuiHandle gui_create_gui(int resx, int resy, const char* window_title, bool vsync_on);
 void gui_destroy_gui(GuiHandle gui_handle);
 
@@ -41,3 +57,9 @@ void gui_draw_rect_filled(GuiHandle gui_handle, Vector2 position, Vector2 size,
 
 void gui_word_wrap(GuiHandle gui_handle, const char* text, FontTemplateHandle font_handle, float max_width, unsigned* row_count, unsigned* row_lengths, unsigned row_lengths_buffer_size);
 Vector2 gui_text_size(GuiHandle gui_handle, const char* text, FontTemplateHandle font_handle);
+
+// Rendered strings are kept as textures until the cache goes over budget, least recently used go first.
+void gui_set_text_cache_budget(GuiHandle gui_handle, size_t byte_budget);
+GuiTextCacheStats gui_get_text_cache_stats(GuiHandle gui_handle);
+
+void gui_set_text_mode(GuiHandle gui_handle, GuiTextMode mode);
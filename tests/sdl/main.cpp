@@ -65,89 +65,76 @@ DebuginatorVector2 text_size(const char* text, DebuginatorFont* font, void* user
 	return *(DebuginatorVector2*)&text_size;
 }
 
-int save_item(const char* path, const char* value, char* save_buffer, int save_buffer_size) {
-	if (save_buffer_size < 512) {
-		return -1;
-	}
-
-	int chars = sprintf_s(save_buffer, save_buffer_size, "%s=%s\n", path, value);
-	return chars;
+void on_text_cache_budget_changed(DebuginatorItem* item, void* value, const char* value_title, void* app_userdata) {
+	(void)item, value_title;
+	int budget_mb = *(int*)value;
+	gui_set_text_cache_budget((GuiHandle)app_userdata, (size_t)budget_mb * 1024 * 1024);
 }
 
-void save(TheDebuginator* debuginator) {
-	int save_buffer_size = 32;
-	char* save_buffer = NULL;
-	while (true) {
-		save_buffer = (char*)malloc(save_buffer_size);
-		memset(save_buffer, 0, save_buffer_size);
-		int saved = debuginator_save(debuginator, save_item, save_buffer, save_buffer_size);
-		if (saved >= 0) {
-			break;
-		}
+void on_text_mode_changed(DebuginatorItem* item, void* value, const char* value_title, void* app_userdata) {
+	(void)item, value_title;
+	gui_set_text_mode((GuiHandle)app_userdata, *(GuiTextMode*)value);
+}
 
-		save_buffer_size *= 16;
-		free(save_buffer);
-	}
+bool save_sink(const char* data, int length, void* userdata) {
+	FILE* file = (FILE*)userdata;
+	return fwrite(data, 1, length, file) == (size_t)length;
+}
 
+void save(TheDebuginator* debuginator) {
 	FILE* file = NULL;
 	int error = fopen_s(&file, "DebuginatorConfig.txt", "w");
 	if (file == NULL || error < 0) {
 		return;
 	}
 
-	fputs(save_buffer, file);
+	debuginator_save_stream(debuginator, save_sink, file);
 	fclose(file);
-	free(save_buffer);
 }
 
-bool load(TheDebuginator* debuginator, char* loaded_data_buffer, int loaded_buffer_size) {
+// Appends what changed since the last save, and compacts the file once the journal grows.
+void save_changes(TheDebuginator* debuginator) {
+	if (debuginator->journal_record_count > 64) {
+		save(debuginator);
+		return;
+	}
+
+	if (debuginator->first_dirty_item == NULL) {
+		return;
+	}
+
 	FILE* file = NULL;
-	int error = fopen_s(&file, "DebuginatorConfig.txt", "r");
+	int error = fopen_s(&file, "DebuginatorConfig.txt", "ab");
 	if (file == NULL || error < 0) {
-		return true;
+		return;
 	}
 
-	bool result = true;
-	char load_buffer[1024] = { 0 };
-	fread_s(load_buffer, 1024, 1, 1023, file);
-	const char* data = load_buffer;
-	while (*data != '\0') {
-		if (loaded_buffer_size < 512) {
-			result = false;
-			break;
-		}
+	debuginator_save_changes(debuginator, save_sink, file);
+	fclose(file);
+}
 
-		const char* key = data;
-		const char* value = NULL;
-		const char* loaded_data_buffer_key = NULL;
-		const char* loaded_data_buffer_value = NULL;
-		while (*data++ != '\0') {
-			if (*data == '=') {
-				memcpy(loaded_data_buffer, key, data - key);
-				loaded_data_buffer[data - key] = 0;
-				loaded_data_buffer_key = loaded_data_buffer;
-				loaded_data_buffer += data - key + 1;
-				loaded_buffer_size -= (int)(data - key + 1);
-				value = (++data);
-			}
+void load(TheDebuginator* debuginator) {
+	FILE* file = NULL;
+	int error = fopen_s(&file, "DebuginatorConfig.txt", "rb");
+	if (file == NULL || error < 0) {
+		return;
+	}
 
-			if (*data == '\n' && value != NULL) {
-				memcpy(loaded_data_buffer, value, data - value);
-				loaded_data_buffer[data - value] = 0;
-				loaded_data_buffer_value = loaded_data_buffer;
-				loaded_data_buffer += data - value + 1;
-				loaded_buffer_size -= (int)(data - value + 1);
-				// Debuginator needs to own this
-				const char* value_title = debuginator_copy_string(debuginator, loaded_data_buffer_value, 0);
-				debuginator_load_item(debuginator, loaded_data_buffer_key, value_title);
-				++data;
-				break;
-			}
-		}
+	fseek(file, 0, SEEK_END);
+	long size = ftell(file);
+	if (size <= 0) {
+		fclose(file);
+		return;
 	}
 
+	fseek(file, 0, SEEK_SET);
+
+	char* data = (char*)malloc(size);
+	size = (long)fread(data, 1, size, file);
 	fclose(file);
-	return result;
+
+	debuginator_load_from_buffer(debuginator, data, (int)size, NULL);
+	free(data);
 }
 
 bool handle_debuginator_input(SDL_Event* event, TheDebuginator* debuginator) {
@@ -167,7 +154,7 @@ bool handle_debuginator_input(SDL_Event* event, TheDebuginator* debuginator) {
 			else if (event->key.keysym.sym == SDLK_LEFT || event->key.keysym.sym == SDLK_ESCAPE) {
 				if (debuginator->is_open && !debuginator->hot_item->leaf.is_expanded) {
 					debuginator_set_open(debuginator, false);
-					save(debuginator);
+					save_changes(debuginator);
 					return true;
 				}
 				else if (!debuginator->hot_item->is_folder && debuginator->hot_item->leaf.is_expanded) {
@@ -268,12 +255,7 @@ int main(int argc, char **argv)
 	TheDebuginator debuginator;
 	debuginator_create(&config, &debuginator);
 
-	char* loaded_data_buffer = (char*)malloc(10 * 1024 * 1024);
-	bool load_result = load(&debuginator, loaded_data_buffer, 10 * 1024 * 1024);
-	if (!load_result) {
-		return 1;
-	}
-	free(loaded_data_buffer);
+	load(&debuginator);
 
 	GameData* gamedata = game_init(gui, &debuginator);
 
@@ -283,6 +265,23 @@ int main(int argc, char **argv)
 	bool show_framerate = true;
 	debuginator_create_bool_item(&debuginator, "SDL Demo/Show framerate", "Shows framerate and frame time in ms.", &show_framerate);
 
+	{
+		static const char* budget_titles[4] = { "0 MB", "1 MB", "8 MB", "32 MB" };
+		static int budgets_mb[4] = { 0, 1, 8, 32 };
+		debuginator_create_array_item(&debuginator, NULL, "SDL Demo/Text cache budget",
+			"How much memory the text texture cache may use. \n0 renders every string every frame.", on_text_cache_budget_changed, NULL,
+			budget_titles, (void*)budgets_mb, 4, sizeof(budgets_mb[0]));
+		debuginator_set_default_value(&debuginator, "SDL Demo/Text cache budget", "8 MB", 0);
+	}
+
+	{
+		static const char* text_mode_titles[2] = { "Cached strings", "Glyph atlas" };
+		static GuiTextMode text_modes[2] = { GUI_TextModeCachedStrings, GUI_TextModeGlyphAtlas };
+		debuginator_create_array_item(&debuginator, NULL, "SDL Demo/Text renderer",
+			"Cached strings renders each string to its own texture. \nGlyph atlas batches all text and rects into one draw call per frame.", on_text_mode_changed, NULL,
+			text_mode_titles, (void*)text_modes, 2, sizeof(text_modes[0]));
+	}
+
 	const char* preset_paths[2] = { "SDL Demo/Throttle framerate", "SDL Demo/Show framerate" };
 	const char* preset_value_titles[2] = { "True", "False" };
 	debuginator_create_preset_item(&debuginator, "SDL Demo/Preset example", preset_paths, preset_value_titles, NULL, 2);
@@ -325,7 +324,9 @@ int main(int argc, char **argv)
 		gui_frame_begin(gui);
 
 		game_update(gamedata, (float)dt);
+		Uint64 draw_start = SDL_GetPerformanceCounter();
 		debuginator_draw(&debuginator, (float)dt);
+		double menu_draw_ms = (SDL_GetPerformanceCounter() - draw_start) * 1000.0 / SDL_GetPerformanceFrequency();
 
 		// Not a good way to enforce a framerate due to delay being inprecise but
 		// its purpose is to save some battery, not to get exactly X fps.
@@ -339,6 +340,17 @@ int main(int argc, char **argv)
 			char fpsstr[64] = { 0 };
 			sprintf_s(fpsstr, 64, "FPS: %.2lf / ms: %.15lf", 1/dt, dt * 1000);
 			gui_draw_text(gui, fpsstr, Vector2(res_x * 0.5f, 20.f), s_fonts[FONT_ItemDescription], Color(255, 255, 0, 255));
+
+			GuiTextCacheStats stats = gui_get_text_cache_stats(gui);
+			char cachestr[128] = { 0 };
+			sprintf_s(cachestr, 128, "Text cache: %u hits / %u misses, %d entries, %d / %d KB",
+				stats.frame_hits, stats.frame_misses, stats.entry_count, (int)(stats.bytes_used / 1024), (int)(stats.byte_budget / 1024));
+			gui_draw_text(gui, cachestr, Vector2(res_x * 0.5f, 45.f), s_fonts[FONT_ItemDescription], Color(255, 255, 0, 255));
+
+			// CPU side only, the batched glyph atlas path submits in gui_frame_end
+			char drawstr[64] = { 0 };
+			sprintf_s(drawstr, 64, "Menu draw CPU ms: %.4lf", menu_draw_ms);
+			gui_draw_text(gui, drawstr, Vector2(res_x * 0.5f, 70.f), s_fonts[FONT_ItemDescription], Color(255, 255, 0, 255));
 		}
 
 		gui_frame_end(gui);
@@ -17,6 +17,8 @@ typedef struct UnitTestData
 	bool generatedbool_target;
 
 	char stringtest[256];
+
+	unsigned word_wrap_calls;
 } UnitTestData;
 
 static UnitTestData g_testdata;
@@ -51,6 +53,7 @@ void draw_rect(DebuginatorVector2* position, DebuginatorVector2* size, Debuginat
 
 #pragma warning(suppress: 4100) // Unreferenced param
 void word_wrap(const char* text, DebuginatorFont font, float max_width, unsigned* row_count, unsigned* row_lengths, unsigned row_lengths_buffer_size, void* app_userdata) {
+	++g_testdata.word_wrap_calls;
 	*row_count = 0;
 }
 
@@ -74,6 +77,53 @@ static void unittest_on_item_changed_stringtest(DebuginatorItem* item, void* val
 #endif
 }
 
+typedef struct UnitTestSaveBuffer {
+	char data[4096];
+	int size;
+	int chunks;
+	int max_chunks;
+} UnitTestSaveBuffer;
+
+static bool unittest_save_sink(const char* data, int length, void* userdata) {
+	UnitTestSaveBuffer* buffer = (UnitTestSaveBuffer*)userdata;
+	if (buffer->chunks == buffer->max_chunks || buffer->size + length >= (int)sizeof(buffer->data)) {
+		return false;
+	}
+
+	memcpy(buffer->data + buffer->size, data, length);
+	buffer->size += length;
+	buffer->data[buffer->size] = '\0';
+	buffer->chunks++;
+	return true;
+}
+
+typedef struct UnitTestCallbackCount {
+	int calls;
+	int last_value;
+} UnitTestCallbackCount;
+
+static void unittest_on_item_changed_count(DebuginatorItem* item, void* value, const char* value_title, void* app_userdata) {
+	(void)value_title;
+	(void)app_userdata;
+	UnitTestCallbackCount* count = (UnitTestCallbackCount*)item->user_data;
+	count->calls++;
+	count->last_value = *(int*)value;
+}
+
+static void unittest_on_range_changed(DebuginatorItem* item, void* value, const char* value_title, void* app_userdata) {
+	(void)value_title;
+	(void)app_userdata;
+	memcpy(item->user_data, value, 4);
+}
+
+// Runs the ranges back to front in small chunks, like a job system might finish them.
+static void unittest_parallel_for(DebuginatorParallelForTask task, void* task_data, int count, void* app_userdata) {
+	(void)app_userdata;
+	for (int end = count; end > 0; end -= 3) {
+		task(task_data, end - 3 > 0 ? end - 3 : 0, end);
+	}
+}
+
 static void unittest_debug_menu_setup(TheDebuginator* debuginator) {
 	debuginator_create_bool_item(debuginator, "SimpleBool 1", "Change a bool.", &g_testdata.simplebool_target);
 	debuginator_create_bool_item(debuginator, "Folder/SimpleBool 2", "Change a bool.", &g_testdata.simplebool_target);
@@ -99,6 +149,8 @@ static void unittest_debug_menu_run() {
 	char* memory_arena = (char*)malloc(memory_arena_capacity);
 	TheDebuginatorConfig config;
 	debuginator_get_default_config(&config);
+	ASSERT(config.command_queue_capacity == 0);
+	config.command_queue_capacity = 64;
 	config.memory_arena = memory_arena;
 	config.memory_arena_capacity = memory_arena_capacity;
 	config.draw_rect = draw_rect;
@@ -152,6 +204,9 @@ static void unittest_debug_menu_run() {
 
 		ASSERT(testdata->simplebool_target == false);
 		ASSERT(testdata->generatedbool_target == false);
+
+		// Descriptions aren't word wrapped until they're needed
+		ASSERT(testdata->word_wrap_calls == 0);
 	}
 	{
 		// Can we add and remove stuff?
@@ -186,6 +241,908 @@ static void unittest_debug_menu_run() {
 
 		ASSERT(game_item->folder.num_visible_children == 9);
 	}
+	{
+		// Expanded descriptions are only word wrapped when something affecting the wrapping changes
+		debuginator_set_hot_item(thed, "Folder 2/String item");
+		debuginator_set_open(thed, true);
+		unsigned word_wrap_calls_before_expanding = testdata->word_wrap_calls;
+		debuginator_move_to_child(thed, false);
+		ASSERT(str_item->leaf.is_expanded == true);
+		ASSERT(testdata->word_wrap_calls == word_wrap_calls_before_expanding + 1);
+		ASSERT(str_item->total_height == debuginator.item_height * (1 + str_item->leaf.description_line_count + 3));
+
+		debuginator_draw(thed, 0.1f);
+		unsigned word_wrap_calls = testdata->word_wrap_calls;
+		debuginator_draw(thed, 0.1f);
+		debuginator_draw(thed, 0.1f);
+		ASSERT(testdata->word_wrap_calls == word_wrap_calls);
+
+		debuginator_set_size(thed, 400, 1000);
+		debuginator_draw(thed, 0.1f);
+		ASSERT(testdata->word_wrap_calls == word_wrap_calls + 1);
+
+		debuginator_set_size(thed, 500, 1000);
+		debuginator_move_to_parent(thed);
+		debuginator_set_open(thed, false);
+	}
+	{
+		// Drawing into a command buffer instead of calling the callbacks
+		DebuginatorDrawCommand commands[256];
+		char string_pool[4096];
+		DebuginatorDrawCommandBuffer command_buffer;
+		memset(&command_buffer, 0, sizeof(command_buffer));
+		command_buffer.commands = commands;
+		command_buffer.command_capacity = 256;
+		command_buffer.string_pool = string_pool;
+		command_buffer.string_pool_capacity = sizeof(string_pool);
+
+		debuginator_set_draw_command_buffer(thed, &command_buffer);
+		debuginator_set_open(thed, true);
+		debuginator_draw(thed, 0.1f);
+		ASSERT(command_buffer.overflowed == false);
+		ASSERT(command_buffer.command_count > 0);
+		ASSERT(command_buffer.commands[0].type == DEBUGINATOR_DrawCommandRect); // Background
+
+		bool found_title = false;
+		for (int i = 0; i < command_buffer.command_count; i++) {
+			DebuginatorDrawCommand* command = &command_buffer.commands[i];
+			if (command->type == DEBUGINATOR_DrawCommandText) {
+				const char* text = debuginator_get_draw_command_text(&command_buffer, command);
+				ASSERT((int)strlen(text) == command->data.text.length);
+				found_title = found_title || strcmp(text, "SimpleBool 1") == 0;
+			}
+		}
+		ASSERT(found_title);
+
+		// Commands that don't fit are dropped
+		command_buffer.command_capacity = 2;
+		debuginator_draw(thed, 0.1f);
+		ASSERT(command_buffer.overflowed == true);
+		ASSERT(command_buffer.command_count == 2);
+
+		debuginator_set_draw_command_buffer(thed, NULL);
+		debuginator_set_open(thed, false);
+	}
+	{
+		// Only the value rows of an expanded item that are on screen are drawn
+		static const char* asset_titles[5000];
+		for (int i = 0; i < 5000; i++) {
+			asset_titles[i] = "Asset";
+		}
+
+		DebuginatorItem* assets_item = debuginator_create_array_item(thed, NULL, "Folder 2/Assets",
+			NULL, NULL, NULL, asset_titles, NULL, 5000, 0);
+		debuginator_set_hot_item(thed, "Folder 2/Assets");
+		debuginator_set_open(thed, true);
+		debuginator_move_to_child(thed, false);
+		ASSERT(assets_item->leaf.is_expanded == true);
+
+		DebuginatorDrawCommand commands[512];
+		char string_pool[8192];
+		DebuginatorDrawCommandBuffer command_buffer;
+		memset(&command_buffer, 0, sizeof(command_buffer));
+		command_buffer.commands = commands;
+		command_buffer.command_capacity = 512;
+		command_buffer.string_pool = string_pool;
+		command_buffer.string_pool_capacity = sizeof(string_pool);
+		debuginator_set_draw_command_buffer(thed, &command_buffer);
+
+		for (int i = 0; i < 3000; i++) {
+			debuginator_move_to_next_leaf(thed, false);
+		}
+
+		for (int i = 0; i < 20; i++) {
+			debuginator_update(thed, 0.1f);
+			debuginator_draw(thed, 0.1f);
+		}
+
+		ASSERT(assets_item->leaf.hot_index == 3000);
+		ASSERT(command_buffer.overflowed == false);
+		ASSERT(command_buffer.command_count < 100);
+
+		debuginator_set_draw_command_buffer(thed, NULL);
+		debuginator_move_to_parent(thed);
+		debuginator_set_open(thed, false);
+		debuginator_remove_item(thed, assets_item);
+	}
+	{
+		// Redraws are only needed when something visible has changed
+		debuginator.hot_item_pulse = false;
+		debuginator_set_open(thed, true);
+		for (int i = 0; i < 50; i++) {
+			debuginator_update(thed, 0.1f);
+			debuginator_draw(thed, 0.1f);
+		}
+
+		ASSERT(debuginator_needs_redraw(thed) == false);
+		ASSERT(debuginator_draw(thed, 0.1f) == false);
+
+		debuginator_request_redraw(thed);
+		ASSERT(debuginator_needs_redraw(thed) == true);
+		ASSERT(debuginator_draw(thed, 0.1f) == true);
+		ASSERT(debuginator_needs_redraw(thed) == false);
+
+		// Changing a value redraws without invalidating the layout
+		unsigned layout_generation = debuginator.layout_generation;
+		sb1_item->leaf.hot_index = 1;
+		debuginator_activate(thed, sb1_item, false);
+		ASSERT(debuginator_needs_redraw(thed) == true);
+		sb1_item->leaf.hot_index = 0;
+		debuginator_activate(thed, sb1_item, false);
+		ASSERT(debuginator.layout_generation == layout_generation);
+
+		debuginator_move_to_next_leaf(thed, false);
+		ASSERT(debuginator_needs_redraw(thed) == true);
+		debuginator_move_to_prev_leaf(thed, false);
+
+		debuginator_set_open(thed, false);
+		for (int i = 0; i < 50; i++) {
+			debuginator_update(thed, 0.1f);
+			debuginator_draw(thed, 0.1f);
+		}
+
+		debuginator.hot_item_pulse = true;
+	}
+	{
+		// Streaming save has no limits on path length or depth
+		const char* deep_path = "Level 01 with a long name/Level 02 with a long name/Level 03 with a long name/Level 04 with a long name/"
+			"Level 05 with a long name/Level 06 with a long name/Level 07 with a long name/Level 08 with a long name/"
+			"Level 09 with a long name/Level 10 with a long name/Deep bool";
+		bool deep_bool = false;
+		DebuginatorItem* deep_item = debuginator_create_bool_item(thed, deep_path, NULL, &deep_bool);
+		deep_item->leaf.hot_index = 1;
+		debuginator_activate(thed, deep_item, false);
+		ASSERT(deep_bool == true);
+
+		UnitTestSaveBuffer save_buffer;
+		memset(&save_buffer, 0, sizeof(save_buffer));
+		save_buffer.max_chunks = 100;
+		int saved = debuginator_save_stream(thed, unittest_save_sink, &save_buffer);
+		ASSERT(saved == save_buffer.size);
+		ASSERT(strstr(save_buffer.data, deep_path) != NULL);
+		ASSERT(strstr(save_buffer.data, "/Deep bool=True\n") != NULL);
+		ASSERT((int)strlen(deep_path) > 256);
+
+		// Only the items that differ from their default are visited
+		ASSERT(deep_item->leaf.is_overridden);
+		deep_item->leaf.hot_index = 0;
+		debuginator_activate(thed, deep_item, false);
+		ASSERT(!deep_item->leaf.is_overridden);
+		for (DebuginatorItem* item = debuginator.first_overridden_item; item != NULL; item = item->leaf.next_overridden) {
+			ASSERT(item != deep_item && item->leaf.active_index != item->leaf.default_index);
+		}
+
+		memset(&save_buffer, 0, sizeof(save_buffer));
+		save_buffer.max_chunks = 100;
+		debuginator_save_stream(thed, unittest_save_sink, &save_buffer);
+		ASSERT(strstr(save_buffer.data, "/Deep bool=") == NULL);
+		deep_item->leaf.hot_index = 1;
+		debuginator_activate(thed, deep_item, false);
+
+		// Aborting stops the save
+		memset(&save_buffer, 0, sizeof(save_buffer));
+		save_buffer.max_chunks = 0;
+		ASSERT(debuginator_save_stream(thed, unittest_save_sink, &save_buffer) == -1);
+
+		debuginator_remove_item_by_path(thed, "Level 01 with a long name");
+		for (DebuginatorItem* item = debuginator.first_overridden_item; item != NULL; item = item->leaf.next_overridden) {
+			ASSERT(item != deep_item);
+		}
+	}
+	{
+		// Animations come from a pool, when it's full the ones closest to finishing are replaced
+		ASSERT(debuginator.animation_capacity == 64);
+		debuginator_set_open(thed, true);
+		for (int i = 0; i < 70; i++) {
+			debuginator_activate(thed, sb1_item, true);
+		}
+
+		ASSERT(debuginator.animation_count == 64);
+		debuginator_draw(thed, 0.1f);
+		ASSERT(debuginator.animation_count == 64);
+		debuginator_draw(thed, 1.0f);
+		ASSERT(debuginator.animation_count == 0);
+
+		debuginator_activate(thed, sb1_item, true);
+		debuginator_remove_item_by_path(thed, "SimpleBool 1");
+		ASSERT(debuginator.animation_count == 0);
+		sb1_item = debuginator_create_bool_item(thed, "SimpleBool 1", "Change a bool.", &g_testdata.simplebool_target);
+		debuginator_set_open(thed, false);
+	}
+	{
+		// Update is free while closed, and reports when it has settled
+		ASSERT(debuginator_update(thed, 0.1f) == false);
+		debuginator.hot_item_pulse = false;
+		debuginator_set_hot_item(thed, "Folder/SimpleBool 3");
+		debuginator_set_open(thed, true);
+		ASSERT(debuginator.current_height_offset == debuginator.size.y * debuginator.focus_height - debuginator__hot_item_distance(thed));
+		ASSERT(debuginator_update(thed, 0.1f) == true);
+
+		bool settled = false;
+		for (int i = 0; i < 50 && !settled; i++) {
+			settled = !debuginator_update(thed, 0.1f);
+			debuginator_draw(thed, 0.1f);
+		}
+
+		ASSERT(settled);
+
+		debuginator_set_open(thed, false);
+		for (int i = 0; i < 50 && debuginator_update(thed, 0.1f); i++) {
+			debuginator_draw(thed, 0.1f);
+		}
+
+		ASSERT(debuginator.openness == 0);
+		debuginator.hot_item_pulse = true;
+	}
+	{
+		// Resizing an item, e.g. when drawing it expanded, invalidates the layout
+		DebuginatorItem* folder_item = sb2_item->parent;
+		int height = sb2_item->total_height;
+		int folder_height = folder_item->total_height;
+		unsigned generation = debuginator.layout_generation;
+		debuginator__set_total_height(thed, sb2_item, height);
+		ASSERT(debuginator.layout_generation == generation);
+		debuginator__set_total_height(thed, sb2_item, height + 10);
+		ASSERT(debuginator.layout_generation != generation);
+		ASSERT(folder_item->total_height == folder_height + 10);
+		debuginator__set_total_height(thed, sb2_item, height);
+		ASSERT(folder_item->total_height == folder_height);
+	}
+	{
+		// Binary save and load round trips, and is sorted by path hash
+		bool binary_bools[20] = { 0 };
+		DebuginatorItem* binary_items[20];
+		char binary_path[64];
+		for (int i = 0; i < 20; i++) {
+			sprintf_s(binary_path, 64, "Binary/Sub %d/Bool %d", i % 3, i);
+			binary_items[i] = debuginator_create_bool_item(thed, binary_path, NULL, &binary_bools[i]);
+			if (i % 2 == 0) {
+				binary_items[i]->leaf.hot_index = 1;
+				debuginator_activate(thed, binary_items[i], false);
+			}
+		}
+
+		int size = debuginator_save_binary(thed, NULL, 0, false);
+		ASSERT(size == 16 + 10 * 16);
+		unsigned char binary_buffer[1024];
+		ASSERT(debuginator_save_binary(thed, binary_buffer, 100, false) == size);
+		ASSERT(debuginator_save_binary(thed, binary_buffer, sizeof(binary_buffer), false) == size);
+		for (int i = 1; i < 10; i++) {
+			ASSERT(debuginator__read_u64(binary_buffer + 16 + i * 16) > debuginator__read_u64(binary_buffer + 16 + (i - 1) * 16));
+		}
+
+		for (int i = 0; i < 20; i++) {
+			binary_items[i]->leaf.hot_index = 0;
+			debuginator_activate(thed, binary_items[i], false);
+		}
+
+		ASSERT(debuginator_load_binary(thed, binary_buffer, size) == 10);
+		for (int i = 0; i < 20; i++) {
+			ASSERT(binary_bools[i] == (i % 2 == 0));
+		}
+
+		int size_with_strings = debuginator_save_binary(thed, binary_buffer, sizeof(binary_buffer), true);
+		ASSERT(size_with_strings > size);
+		ASSERT(memcmp(binary_buffer + size, "Binary/Sub 0/Bool 0=True\n", 25) == 0);
+		ASSERT(debuginator_load_binary(thed, binary_buffer, size_with_strings) == 10);
+
+		binary_buffer[0] = 'X';
+		ASSERT(debuginator_load_binary(thed, binary_buffer, size) == -1);
+		ASSERT(debuginator_load_binary(thed, binary_buffer, 8) == -1);
+
+		debuginator_remove_item_by_path(thed, "Binary");
+	}
+	{
+		// Loading items that don't exist yet doesn't create any items
+		char loaded_value[8] = "True";
+		debuginator_load_item(thed, "Pending/Later bool", loaded_value);
+		loaded_value[0] = '\0';
+		ASSERT(debuginator_get_item(thed, NULL, "Pending", false) == NULL);
+		ASSERT(debuginator.pending_load_count == 1);
+
+		bool later_bool = false;
+		DebuginatorItem* later_item = debuginator_create_bool_item(thed, "Pending/Later bool", NULL, &later_bool);
+		ASSERT(later_bool == true);
+		ASSERT(debuginator.pending_load_count == 0);
+
+		// Same for binary loads, and the existing items are still set right away
+		bool early_bool = false;
+		DebuginatorItem* early_item = debuginator_create_bool_item(thed, "Pending/Early bool", NULL, &early_bool);
+		early_item->leaf.hot_index = 1;
+		debuginator_activate(thed, early_item, false);
+
+		unsigned char binary_buffer[256];
+		int size = debuginator_save_binary(thed, binary_buffer, sizeof(binary_buffer), false);
+		debuginator_remove_item(thed, later_item);
+		early_item->leaf.hot_index = 0;
+		debuginator_activate(thed, early_item, false);
+		later_bool = false;
+
+		ASSERT(debuginator_load_binary(thed, binary_buffer, size) == 1);
+		ASSERT(early_bool == true);
+		ASSERT(debuginator.pending_load_count == 1);
+		debuginator_create_bool_item(thed, "Pending/Later bool", NULL, &later_bool);
+		ASSERT(later_bool == true);
+		ASSERT(debuginator.pending_load_count == 0);
+
+		debuginator_remove_item_by_path(thed, "Pending");
+	}
+	{
+		// Loading from a buffer handles comments, CRLF and doesn't read past the end
+		bool first_bool = false;
+		bool second_bool = false;
+		debuginator_create_bool_item(thed, "Parsed/First bool", NULL, &first_bool);
+		const char* settings = "# A comment\r\n"
+			"; Another comment\n"
+			"Parsed/First bool=True\r\n"
+			"\n"
+			"Not a setting\n"
+			"Parsed/Second bool=True\n"
+			"Parsed/Third bool=True";
+		int size = (int)strlen(settings) - 2;
+		int num_dropped = -1;
+		ASSERT(debuginator_load_from_buffer(thed, settings, size, &num_dropped) == 3);
+		ASSERT(num_dropped == 0);
+		ASSERT(first_bool == true);
+		ASSERT(debuginator.pending_load_count == 2);
+
+		debuginator_create_bool_item(thed, "Parsed/Second bool", NULL, &second_bool);
+		ASSERT(second_bool == true);
+
+		// The last line was cut short so its value doesn't match
+		bool third_bool = false;
+		DebuginatorItem* third_item = debuginator_create_bool_item(thed, "Parsed/Third bool", NULL, &third_bool);
+		ASSERT(third_bool == false);
+		ASSERT(third_item->leaf.active_index == 0);
+		ASSERT(debuginator.pending_load_count == 0);
+
+		debuginator_remove_item_by_path(thed, "Parsed");
+	}
+	{
+		// Loads for items that exist take no memory, the rest are dropped once the arena is full
+		int small_arena_capacity = 1024 * 256;
+		char* small_arena = (char*)malloc(small_arena_capacity);
+		TheDebuginatorConfig small_config = config;
+		small_config.memory_arena = small_arena;
+		small_config.memory_arena_capacity = small_arena_capacity;
+		static TheDebuginator small_debuginator;
+		debuginator_create(&small_config, &small_debuginator);
+
+		bool existing_bool = false;
+		debuginator_create_bool_item(&small_debuginator, "Existing bool", NULL, &existing_bool);
+
+		int num_lines = 20000;
+		int line_capacity = 32;
+		char* lines = (char*)malloc(num_lines * line_capacity);
+		int lines_size = 0;
+		for (int i = 0; i < num_lines - 1; i++) {
+			lines_size += sprintf_s(lines + lines_size, line_capacity, "Missing/Item %d=True\n", i);
+		}
+		lines_size += sprintf_s(lines + lines_size, line_capacity, "Existing bool=True\n");
+
+		int num_dropped = 0;
+		ASSERT(debuginator_load_from_buffer(&small_debuginator, lines, lines_size, &num_dropped) == num_lines);
+		ASSERT(num_dropped > 0);
+		ASSERT(small_debuginator.pending_load_count + num_dropped == num_lines - 1);
+		ASSERT(existing_bool == true);
+
+		free(lines);
+		free(small_arena);
+	}
+	{
+		// Only items changed since the last save are journaled, and loading doesn't count as a change
+		UnitTestSaveBuffer save_buffer;
+		memset(&save_buffer, 0, sizeof(save_buffer));
+		save_buffer.max_chunks = 100;
+		ASSERT(debuginator_save_stream(thed, unittest_save_sink, &save_buffer) >= 0);
+		ASSERT(debuginator.first_dirty_item == NULL);
+
+		bool journal_bools[3] = { 0 };
+		DebuginatorItem* journal_items[3];
+		journal_items[0] = debuginator_create_bool_item(thed, "Journal/Bool 0", NULL, &journal_bools[0]);
+		journal_items[1] = debuginator_create_bool_item(thed, "Journal/Bool 1", NULL, &journal_bools[1]);
+		journal_items[2] = debuginator_create_bool_item(thed, "Journal/Bool 2", NULL, &journal_bools[2]);
+		debuginator_load_item(thed, "Journal/Bool 2", "True");
+		ASSERT(journal_bools[2] == true);
+		ASSERT(debuginator.first_dirty_item == NULL);
+
+		journal_items[0]->leaf.hot_index = 1;
+		debuginator_activate(thed, journal_items[0], false);
+		debuginator_activate(thed, journal_items[0], false);
+		journal_items[1]->leaf.hot_index = 1;
+		debuginator_activate(thed, journal_items[1], false);
+		journal_items[1]->leaf.hot_index = 0;
+		debuginator_activate(thed, journal_items[1], false);
+
+		memset(&save_buffer, 0, sizeof(save_buffer));
+		save_buffer.max_chunks = 100;
+		ASSERT(debuginator_save_changes(thed, unittest_save_sink, &save_buffer) == save_buffer.size);
+		ASSERT(strstr(save_buffer.data, "Journal/Bool 0=True\n") != NULL);
+		ASSERT(strstr(save_buffer.data, "Journal/Bool 1=False\n") != NULL);
+		ASSERT(strstr(save_buffer.data, "Journal/Bool 2") == NULL);
+		ASSERT(debuginator.journal_record_count == 2);
+
+		// Nothing changed, nothing written
+		ASSERT(debuginator_save_changes(thed, unittest_save_sink, &save_buffer) == 0);
+
+		// Removed items leave the dirty list
+		debuginator_activate(thed, journal_items[2], false);
+		debuginator_remove_item(thed, journal_items[2]);
+		ASSERT(debuginator.first_dirty_item == NULL);
+
+		// A full save compacts the journal
+		debuginator_activate(thed, journal_items[1], false);
+		memset(&save_buffer, 0, sizeof(save_buffer));
+		save_buffer.max_chunks = 100;
+		debuginator_save_stream(thed, unittest_save_sink, &save_buffer);
+		ASSERT(debuginator.journal_record_count == 0);
+		ASSERT(debuginator.first_dirty_item == NULL);
+
+		debuginator_remove_item_by_path(thed, "Journal");
+	}
+	{
+		// Items with many values find them by title through a hash index
+		static char many_titles_data[2000][16];
+		static const char* many_titles[2000];
+		static int many_values[2000];
+		for (int i = 0; i < 2000; i++) {
+			sprintf_s(many_titles_data[i], 16, "Value %d", i);
+			many_titles[i] = many_titles_data[i];
+			many_values[i] = i;
+		}
+
+		DebuginatorItem* many_item = debuginator_create_array_item(thed, NULL, "Many values", NULL, NULL, NULL, many_titles, many_values, 2000, sizeof(int));
+		ASSERT(many_item->leaf.value_title_index == NULL);
+		debuginator_load_item(thed, "Many values", "Value 1777");
+		ASSERT(many_item->leaf.active_index == 1777);
+		ASSERT(many_item->leaf.value_title_index != NULL);
+
+		debuginator_set_default_value(thed, "Many values", "Value 5", 0);
+		ASSERT(many_item->leaf.default_index == 5);
+		debuginator_set_default_value(thed, "Many values", "Not a value", 7);
+		ASSERT(many_item->leaf.default_index == 7);
+
+		// Changing the values drops the index
+		debuginator_create_array_item(thed, NULL, "Many values", NULL, NULL, NULL, many_titles + 1000, many_values + 1000, 1000, sizeof(int));
+		ASSERT(many_item->leaf.value_title_index == NULL);
+		debuginator_load_item(thed, "Many values", "Value 1777");
+		ASSERT(many_item->leaf.active_index == 777);
+
+		debuginator_remove_item(thed, many_item);
+	}
+	{
+		// Restoring a snapshot only activates the items that differ
+		bool snapshot_bools[4] = { 0 };
+		DebuginatorItem* snapshot_items[4];
+		char snapshot_path[64];
+		for (int i = 0; i < 4; i++) {
+			sprintf_s(snapshot_path, 64, "Snapshot/Bool %d", i);
+			snapshot_items[i] = debuginator_create_bool_item(thed, snapshot_path, NULL, &snapshot_bools[i]);
+		}
+
+		snapshot_items[1]->leaf.hot_index = 1;
+		debuginator_activate(thed, snapshot_items[1], false);
+
+		static unsigned char snapshot[64 * 1024];
+		int size = debuginator_snapshot(thed, snapshot, sizeof(snapshot));
+		ASSERT(size <= (int)sizeof(snapshot));
+		ASSERT(debuginator_restore(thed, snapshot, size) == 0);
+
+		for (int i = 0; i < 4; i++) {
+			snapshot_items[i]->leaf.hot_index = i < 2 ? 0 : 1;
+			debuginator_activate(thed, snapshot_items[i], false);
+		}
+
+		ASSERT(debuginator_restore(thed, snapshot, size) == 3);
+		ASSERT(snapshot_bools[0] == false);
+		ASSERT(snapshot_bools[1] == true);
+		ASSERT(snapshot_bools[2] == false);
+		ASSERT(snapshot_bools[3] == false);
+		ASSERT(debuginator.pending_load_count == 0);
+
+		// Removed items are skipped and not kept around
+		debuginator_remove_item(thed, snapshot_items[3]);
+		snapshot_items[1]->leaf.hot_index = 0;
+		debuginator_activate(thed, snapshot_items[1], false);
+		ASSERT(debuginator_restore(thed, snapshot, size) == 1);
+		ASSERT(debuginator.pending_load_count == 0);
+
+		debuginator_remove_item_by_path(thed, "Snapshot");
+	}
+	{
+		// Queued commands run in order in debuginator_update, a bounded number per call
+		ASSERT(debuginator.command_queue_capacity == 64);
+		bool queued_bool = false;
+		static const char* queued_titles[] = { "Off", "On" };
+		static bool queued_values[] = { false, true };
+		char queued_description[32] = "Made on a worker";
+		ASSERT(debuginator_queue_create_item(thed, "Queued/Bool", queued_description, debuginator_copy_1byte, &queued_bool, queued_titles, queued_values, 2, sizeof(bool)));
+		queued_description[0] = '\0';
+		ASSERT(debuginator_queue_set_value(thed, "Queued/Bool", "On"));
+		ASSERT(debuginator_queue_set_description(thed, "Queued/Bool", "Changed on a worker"));
+		ASSERT(debuginator_get_item(thed, NULL, "Queued/Bool", false) == NULL);
+
+		debuginator.commands_per_update = 2;
+		ASSERT(debuginator_update(thed, 0.1f) == true);
+		DebuginatorItem* queued_item = debuginator_get_item(thed, NULL, "Queued/Bool", false);
+		ASSERT(queued_item != NULL);
+		ASSERT(strcmp(queued_item->leaf.description, "Made on a worker") == 0);
+		ASSERT(queued_bool == true);
+
+		ASSERT(debuginator_update(thed, 0.1f) == false);
+		ASSERT(strcmp(queued_item->leaf.description, "Changed on a worker") == 0);
+		debuginator.commands_per_update = 64;
+
+		// A full queue refuses more commands, and wraps around once drained
+		int num_queued = 0;
+		while (debuginator_queue_set_value(thed, "Queued/Bool", num_queued % 2 == 0 ? "Off" : "On")) {
+			num_queued++;
+		}
+
+		ASSERT(num_queued == 64);
+		ASSERT(debuginator_update(thed, 0.1f) == false);
+		ASSERT(queued_bool == true);
+		ASSERT(debuginator_queue_remove_item(thed, "Queued"));
+		debuginator_update(thed, 0.1f);
+		ASSERT(debuginator_get_item(thed, NULL, "Queued", false) == NULL);
+	}
+	{
+		// Draw snapshots hand the latest changed frame to the reader
+		static DebuginatorDrawCommand snapshot_commands[3][256];
+		static char snapshot_strings[3][4096];
+		DebuginatorDrawSnapshots snapshots;
+		memset(&snapshots, 0, sizeof(snapshots));
+		for (int i = 0; i < 3; i++) {
+			snapshots.buffers[i].commands = snapshot_commands[i];
+			snapshots.buffers[i].command_capacity = 256;
+			snapshots.buffers[i].string_pool = snapshot_strings[i];
+			snapshots.buffers[i].string_pool_capacity = sizeof(snapshot_strings[i]);
+		}
+
+		debuginator.hot_item_pulse = false;
+		debuginator_set_draw_snapshots(thed, &snapshots);
+		const DebuginatorDrawCommandBuffer* frame = debuginator_acquire_draw_snapshot(&snapshots);
+		ASSERT(frame->command_count == 0);
+
+		debuginator_set_open(thed, true);
+		for (int i = 0; i < 50; i++) {
+			debuginator_update(thed, 0.1f);
+			debuginator_draw(thed, 0.1f);
+		}
+
+		frame = debuginator_acquire_draw_snapshot(&snapshots);
+		ASSERT(frame->command_count > 0);
+		ASSERT(debuginator_acquire_draw_snapshot(&snapshots) == frame);
+
+		// Unchanged frames aren't published, so the reader keeps its frame
+		ASSERT(debuginator_draw(thed, 0.1f) == false);
+		ASSERT(debuginator_acquire_draw_snapshot(&snapshots) == frame);
+
+		// The writer never writes into the buffer the reader holds
+		debuginator_move_to_next_leaf(thed, false);
+		debuginator_draw(thed, 0.1f);
+		debuginator_move_to_prev_leaf(thed, false);
+		debuginator_draw(thed, 0.1f);
+		ASSERT(snapshots.write_index != snapshots.read_index);
+		const DebuginatorDrawCommandBuffer* next_frame = debuginator_acquire_draw_snapshot(&snapshots);
+		ASSERT(next_frame != frame);
+		ASSERT(next_frame->command_count > 0);
+
+		debuginator_set_draw_snapshots(thed, NULL);
+		debuginator_set_open(thed, false);
+		for (int i = 0; i < 50 && debuginator_update(thed, 0.1f); i++) {
+			debuginator_draw(thed, 0.1f);
+		}
+
+		debuginator.hot_item_pulse = true;
+	}
+
+	{
+		// Deferred callbacks are coalesced per item until flushed
+		static const char* deferred_titles[] = { "Zero", "One", "Two" };
+		static int deferred_values[] = { 0, 1, 2 };
+		UnitTestCallbackCount deferred_counts[3];
+		memset(deferred_counts, 0, sizeof(deferred_counts));
+		DebuginatorItem* deferred_items[3];
+		const char* deferred_paths[3] = { "Deferred/Int 0", "Deferred/Int 1", "Deferred/Int 2" };
+		const char* deferred_preset_titles[3] = { "Two", "Two", "One" };
+		for (int i = 0; i < 3; i++) {
+			deferred_items[i] = debuginator_create_array_item(thed, NULL, deferred_paths[i], NULL, unittest_on_item_changed_count, &deferred_counts[i], deferred_titles, deferred_values, 3, sizeof(int));
+		}
+
+		DebuginatorItem* deferred_preset = debuginator_create_preset_item(thed, "Deferred/Preset", deferred_paths, deferred_preset_titles, NULL, 3);
+
+		debuginator_set_deferred_callbacks(thed, true);
+		deferred_items[0]->leaf.hot_index = 1;
+		debuginator_activate(thed, deferred_items[0], false);
+		deferred_preset->leaf.hot_index = 0;
+		debuginator_activate(thed, deferred_preset, false);
+		ASSERT(deferred_counts[0].calls == 0);
+		ASSERT(deferred_items[0]->leaf.active_index == 1);
+
+		// The preset's own callback runs in the flush, and the items it activates are flushed with it
+		ASSERT(debuginator_flush_item_changed_callbacks(thed) == 5);
+		ASSERT(debuginator_flush_item_changed_callbacks(thed) == 0);
+		ASSERT(deferred_counts[0].calls == 2);
+		ASSERT(deferred_counts[0].last_value == 2);
+		ASSERT(deferred_counts[2].calls == 1);
+		ASSERT(deferred_counts[2].last_value == 1);
+
+		// Repeated changes to one item end up as one callback with the last value
+		for (int i = 0; i < 3; i++) {
+			deferred_items[1]->leaf.hot_index = i;
+			debuginator_activate(thed, deferred_items[1], false);
+		}
+
+		// Re-creating an item drops its queued callback, its values may be gone
+		deferred_items[2] = debuginator_create_array_item(thed, NULL, deferred_paths[2], NULL, unittest_on_item_changed_count, &deferred_counts[2], deferred_titles, deferred_values, 3, sizeof(int));
+		deferred_items[2]->leaf.hot_index = 2;
+		debuginator_activate(thed, deferred_items[2], false);
+		debuginator_create_array_item(thed, NULL, deferred_paths[2], NULL, unittest_on_item_changed_count, &deferred_counts[2], deferred_titles, deferred_values, 1, sizeof(int));
+		ASSERT(deferred_items[2]->leaf.has_deferred_callback == false);
+
+		debuginator_remove_item(thed, deferred_items[2]);
+		deferred_items[2] = NULL;
+		debuginator_set_deferred_callbacks(thed, false);
+		ASSERT(deferred_counts[1].calls == 2);
+		ASSERT(deferred_counts[1].last_value == 2);
+		ASSERT(debuginator.first_deferred_item == NULL);
+
+		// Restoring a snapshot queues the callbacks and calls them together at the end
+		static unsigned char deferred_snapshot[64 * 1024];
+		int deferred_snapshot_size = debuginator_snapshot(thed, deferred_snapshot, sizeof(deferred_snapshot));
+		for (int i = 0; i < 2; i++) {
+			deferred_items[i]->leaf.hot_index = 0;
+			debuginator_activate(thed, deferred_items[i], false);
+		}
+
+		memset(deferred_counts, 0, sizeof(deferred_counts));
+		ASSERT(debuginator_restore(thed, deferred_snapshot, deferred_snapshot_size) == 2);
+		ASSERT(debuginator.defer_callbacks == false);
+		ASSERT(debuginator.first_deferred_item == NULL);
+		ASSERT(deferred_counts[0].calls == 1 && deferred_counts[0].last_value == 2);
+		ASSERT(deferred_counts[1].calls == 1 && deferred_counts[1].last_value == 2);
+
+		// If callbacks are already deferred they stay queued
+		for (int i = 0; i < 2; i++) {
+			deferred_items[i]->leaf.hot_index = 0;
+			debuginator_activate(thed, deferred_items[i], false);
+		}
+
+		memset(deferred_counts, 0, sizeof(deferred_counts));
+		debuginator_set_deferred_callbacks(thed, true);
+		ASSERT(debuginator_restore(thed, deferred_snapshot, deferred_snapshot_size) == 2);
+		ASSERT(deferred_counts[0].calls == 0);
+		ASSERT(debuginator_flush_item_changed_callbacks(thed) == 2);
+		debuginator_set_deferred_callbacks(thed, false);
+
+		debuginator_remove_item_by_path(thed, "Deferred");
+	}
+
+	{
+		// Atomic items store into their targets and bump the settings epoch
+		DebuginatorAtomicBool atomic_bool = { 1 };
+		DebuginatorAtomicFloat atomic_float = { 0 };
+		DebuginatorAtomicInt atomic_enum = { 0 };
+		static const char* float_titles[] = { "Half", "Two" };
+		static float float_values[] = { 0.5f, 2.0f };
+		static const char* enum_titles[] = { "Low", "High" };
+		static uint8_t enum_values[] = { 1, 200 };
+
+		DebuginatorItem* bool_item = debuginator_create_atomic_bool_item(thed, "Atomic/Bool", NULL, &atomic_bool);
+		ASSERT(bool_item->leaf.default_index == 1);
+		DebuginatorItem* float_item = debuginator_create_atomic_float_item(thed, "Atomic/Float", NULL, &atomic_float, float_titles, float_values, 2);
+		DebuginatorItem* enum_item = debuginator_create_atomic_enum_item(thed, "Atomic/Enum", NULL, &atomic_enum, enum_titles, enum_values, 2, sizeof(uint8_t));
+
+		unsigned epoch = debuginator_get_settings_epoch(thed);
+		bool_item->leaf.hot_index = 0;
+		debuginator_activate(thed, bool_item, false);
+		float_item->leaf.hot_index = 1;
+		debuginator_activate(thed, float_item, false);
+		enum_item->leaf.hot_index = 1;
+		debuginator_activate(thed, enum_item, false);
+		ASSERT(debuginator_atomic_bool_get(&atomic_bool) == false);
+		ASSERT(debuginator_atomic_float_get(&atomic_float) == 2.0f);
+		ASSERT(debuginator_atomic_int_get(&atomic_enum) == 200);
+		ASSERT(debuginator_get_settings_epoch(thed) == epoch + 3);
+
+		// A value loaded before creation wins over the target's value, which stays the default
+		DebuginatorAtomicInt atomic_level = { 0 };
+		static const char* level_titles[] = { "Low", "Mid", "High" };
+		static int level_values[] = { 0, 1, 2 };
+		debuginator_load_item(thed, "Atomic/Level", "High");
+		DebuginatorItem* level_item = debuginator_create_atomic_int_item(thed, "Atomic/Level", NULL, &atomic_level, level_titles, level_values, 3);
+		ASSERT(debuginator_atomic_int_get(&atomic_level) == 2);
+		ASSERT(level_item->leaf.active_index == 2);
+		ASSERT(level_item->leaf.default_index == 0);
+		ASSERT(level_item->leaf.is_overridden);
+
+		UnitTestSaveBuffer save_buffer;
+		memset(&save_buffer, 0, sizeof(save_buffer));
+		save_buffer.max_chunks = 100;
+		debuginator_save_stream(thed, unittest_save_sink, &save_buffer);
+		ASSERT(strstr(save_buffer.data, "Atomic/Level=High\n") != NULL);
+
+		debuginator_remove_item_by_path(thed, "Atomic");
+	}
+
+	{
+		// Instances share no state, not even the values of their built in items
+		int other_arena_capacity = 1024 * 256;
+		char* other_arena = (char*)malloc(other_arena_capacity);
+		TheDebuginatorConfig other_config = config;
+		other_config.memory_arena = other_arena;
+		other_config.memory_arena_capacity = other_arena_capacity;
+		other_config.create_default_debuginator_items = true;
+		static TheDebuginator other_debuginator;
+		debuginator_create(&other_config, &other_debuginator);
+
+		bool other_bool = false;
+		DebuginatorItem* other_bool_item = debuginator_create_bool_item(&other_debuginator, "Other bool", NULL, &other_bool);
+		ASSERT(other_bool_item->leaf.values == (void*)other_debuginator.bool_values);
+		ASSERT(sb1_item->leaf.values == (void*)debuginator.bool_values);
+
+		DebuginatorItem* theme_item = debuginator_get_item(&other_debuginator, NULL, "Debuginator/Theme", false);
+		ASSERT(theme_item->leaf.values == (void*)other_debuginator.theme_values);
+		theme_item->leaf.hot_index = 2;
+		debuginator_activate(&other_debuginator, theme_item, false);
+		ASSERT(other_debuginator.theme_index == 2);
+		ASSERT(debuginator.theme_index == 0);
+
+		free(other_arena);
+	}
+
+	{
+		// Filtering through parallel_for gives the same result as filtering serially
+		TheDebuginatorConfig filter_config = config;
+		filter_config.memory_arena_capacity = 1024 * 256;
+		filter_config.parallel_for = unittest_parallel_for;
+		filter_config.filter_batch_size = 8; // Several batches
+		static TheDebuginator filter_debuginators[2];
+		char* filter_arenas[2];
+		for (int i = 0; i < 2; i++) {
+			filter_arenas[i] = (char*)malloc(filter_config.memory_arena_capacity);
+			filter_config.memory_arena = filter_arenas[i];
+			filter_config.parallel_for = i == 0 ? NULL : unittest_parallel_for;
+			debuginator_create(&filter_config, &filter_debuginators[i]);
+
+			char filter_path[64];
+			for (int item_i = 0; item_i < 100; item_i++) {
+				sprintf_s(filter_path, 64, "Folder %d/Sub %d/Item %d", item_i % 7, item_i % 3, item_i);
+				debuginator_create_array_item(&filter_debuginators[i], NULL, filter_path, NULL, NULL, NULL, NULL, NULL, 0, 0);
+			}
+			debuginator_set_hot_item(&filter_debuginators[i], "Folder 0/Sub 0/Item 0");
+		}
+
+		ASSERT(filter_debuginators[0].parallel_for == NULL);
+		ASSERT(filter_debuginators[1].parallel_for == unittest_parallel_for);
+
+		const char* filters[] = { "it 4", "sub 2 it", "fo5", "it" };
+		for (int filter_i = 0; filter_i < 4; filter_i++) {
+			// The filter is read as a fixed size buffer, like debuginator->filter
+			char filter[32] = { 0 };
+			sprintf_s(filter, sizeof(filter), "%s", filters[filter_i]);
+			for (int i = 0; i < 2; i++) {
+				debuginator_update_filter(&filter_debuginators[i], filter);
+			}
+
+			ASSERT(strcmp(filter_debuginators[0].hot_item->title, filter_debuginators[1].hot_item->title) == 0);
+			char filter_path[64];
+			int num_visible = 0;
+			for (int item_i = 0; item_i < 100; item_i++) {
+				sprintf_s(filter_path, 64, "Folder %d/Sub %d/Item %d", item_i % 7, item_i % 3, item_i);
+				bool serial_filtered = debuginator_get_item(&filter_debuginators[0], NULL, filter_path, false)->is_filtered;
+				ASSERT(serial_filtered == debuginator_get_item(&filter_debuginators[1], NULL, filter_path, false)->is_filtered);
+				num_visible += serial_filtered ? 0 : 1;
+			}
+
+			ASSERT(num_visible > 0 && (num_visible < 100 || filter_i == 3));
+		}
+
+		free(filter_arenas[0]);
+		free(filter_arenas[1]);
+	}
+
+	{
+		// Range items make their titles and values when needed
+		float range_float = 0;
+		int range_int = 0;
+		DebuginatorItem* float_item = debuginator_create_float_range_item(thed, "Range/Float", NULL, unittest_on_range_changed, &range_float, 0.0f, 10.0f, 0.01f, NULL);
+		DebuginatorItem* int_item = debuginator_create_int_range_item(thed, "Range/Int", NULL, unittest_on_range_changed, &range_int, -50, 50, 5, "x%d");
+		ASSERT(float_item->leaf.num_values == 1001);
+		ASSERT(float_item->leaf.value_titles == NULL);
+		ASSERT(int_item->leaf.num_values == 21);
+
+		// The last value doesn't go past max when the step doesn't divide the range
+		float uneven_float = 0;
+		DebuginatorItem* uneven_item = debuginator_create_float_range_item(thed, "Range/Uneven", NULL, unittest_on_range_changed, &uneven_float, 0.0f, 1.0f, 0.4f, NULL);
+		ASSERT(uneven_item->leaf.num_values == 3);
+		ASSERT(strcmp(debuginator__value_title(&debuginator, uneven_item, 2), "0.80") == 0);
+
+		float_item->leaf.hot_index = 250;
+		debuginator_activate(thed, float_item, false);
+		ASSERT(range_float == 2.5f);
+
+		// Loading and presets find values by their titles
+		debuginator_load_item(thed, "Range/Float", "3.14");
+		ASSERT(float_item->leaf.active_index == 314);
+		debuginator_load_item(thed, "Range/Float", "not a number");
+		ASSERT(float_item->leaf.active_index == 314);
+
+		const char* range_preset_paths[] = { "Range/Int" };
+		const char* range_preset_titles[] = { "x-15" };
+		DebuginatorItem* range_preset = debuginator_create_preset_item(thed, "Range/Preset", range_preset_paths, range_preset_titles, NULL, 1);
+		range_preset->leaf.hot_index = 0;
+		debuginator_activate(thed, range_preset, false);
+		ASSERT(int_item->leaf.active_index == 7);
+		ASSERT(range_int == -15);
+
+		UnitTestSaveBuffer save_buffer;
+		memset(&save_buffer, 0, sizeof(save_buffer));
+		save_buffer.max_chunks = 100;
+		debuginator_save_stream(thed, unittest_save_sink, &save_buffer);
+		ASSERT(strstr(save_buffer.data, "Range/Float=3.14\n") != NULL);
+		ASSERT(strstr(save_buffer.data, "Range/Int=x-15\n") != NULL);
+
+		debuginator_remove_item_by_path(thed, "Range");
+	}
+
+	{
+		// Watch items format their target at most once per refresh, and only when drawn
+		int watched_int = 7;
+		uint64_t watched_counter = 123456789012ull;
+		DebuginatorItem* watch_item = debuginator_create_watch_item(thed, "Watch/Int", NULL, DEBUGINATOR_WatchInt, &watched_int, "%d fps");
+		DebuginatorItem* counter_item = debuginator_create_watch_item(thed, "Watch/Counter", NULL, DEBUGINATOR_WatchCounter, &watched_counter, NULL);
+		DebuginatorWatch* watch = (DebuginatorWatch*)watch_item->leaf.values;
+		DebuginatorWatch* counter_watch = (DebuginatorWatch*)counter_item->leaf.values;
+		ASSERT(debuginator.watch_item_count == 2);
+
+		debuginator_set_hot_item(thed, "Watch/Int");
+		debuginator_set_open(thed, true);
+		for (int i = 0; i < 50; i++) {
+			debuginator_update(thed, 0.02f);
+			debuginator_draw(thed, 0.02f);
+		}
+
+		ASSERT(strcmp(watch->text, "7 fps") == 0);
+		ASSERT(strcmp(counter_watch->text, "123456789012") == 0);
+
+		// Expanding a watch only shows its description
+		debuginator_move_to_child(thed, false);
+		ASSERT(watch_item->leaf.is_expanded);
+		debuginator_update(thed, 0.02f);
+		debuginator_draw(thed, 0.02f);
+		debuginator_move_to_parent(thed);
+		debuginator_set_hot_item(thed, "Watch/Int");
+
+		// Throttled until the refresh interval has passed, but update keeps asking to be called
+		watched_int = 60;
+		debuginator.watch_timer = 0;
+		debuginator.hot_item_pulse = false;
+		ASSERT(debuginator_update(thed, 0.1f) == true);
+		debuginator.hot_item_pulse = true;
+		debuginator_draw(thed, 0.1f);
+		ASSERT(strcmp(watch->text, "7 fps") == 0);
+		ASSERT(debuginator_update(thed, 0.2f) == true);
+		debuginator_draw(thed, 0.2f);
+		ASSERT(strcmp(watch->text, "60 fps") == 0);
+
+		// Nothing is formatted while closed
+		debuginator_set_open(thed, false);
+		for (int i = 0; i < 50 && debuginator_update(thed, 0.1f); i++) {
+			debuginator_draw(thed, 0.1f);
+		}
+
+		unsigned closed_generation = debuginator.watch_generation;
+		watched_int = 30;
+		debuginator_update(thed, 1.0f);
+		debuginator_draw(thed, 1.0f);
+		ASSERT(debuginator.watch_generation == closed_generation);
+		ASSERT(strcmp(watch->text, "60 fps") == 0);
+
+		debuginator_remove_item_by_path(thed, "Watch");
+		ASSERT(debuginator.watch_item_count == 0);
+	}
 
 	/*
 	{
@@ -117,11 +117,69 @@ typedef void (*DebuginatorOnOpenChangedCallback)
 typedef void(*DebuginatorOnItemChangedCallback)(DebuginatorItem* item, void* value, const char* value_title, void* app_userdata);
 typedef int(*DebuginatorSaveItemCallback)(const char* path, const char* value, char* save_buffer, int save_buffer_size);
 
+// Gets called with consecutive chunks of saved data. They're not null terminated. Return false to abort.
+typedef bool(*DebuginatorSaveSinkCallback)(const char* data, int length, void* userdata);
+
+// Should call task for ranges [begin, end) that together cover [0, count), on as many threads as you like,
+// and return when all of them are done. How the range is split doesn't affect the result.
+typedef void(*DebuginatorParallelForTask)(void* task_data, int begin, int end);
+typedef void(*DebuginatorParallelForCallback)(DebuginatorParallelForTask task, void* task_data, int count, void* app_userdata);
+
+typedef enum DebuginatorDrawCommandType {
+	DEBUGINATOR_DrawCommandRect,
+	DEBUGINATOR_DrawCommandText,
+} DebuginatorDrawCommandType;
+
+typedef struct DebuginatorDrawCommand {
+	DebuginatorDrawCommandType type;
+	DebuginatorVector2 position;
+	DebuginatorColor color;
+	union {
+		struct {
+			DebuginatorVector2 size;
+		} rect;
+		struct {
+			// Where the null terminated text is in the buffer's string_pool, see debuginator_get_draw_command_text.
+			int offset;
+			int length;
+			DebuginatorFont font;
+		} text;
+	} data;
+} DebuginatorDrawCommand;
+
+// Owned by the application. When set on The Debuginator, debuginator_draw writes into this
+// instead of calling draw_rect and draw_text. It's cleared at the start of each draw.
+typedef struct DebuginatorDrawCommandBuffer {
+	DebuginatorDrawCommand* commands;
+	int command_capacity;
+	int command_count;
+
+	char* string_pool;
+	int string_pool_capacity;
+	int string_pool_size;
+
+	// Set if a command or its text didn't fit. Those commands are dropped.
+	bool overflowed;
+} DebuginatorDrawCommandBuffer;
+
+// Three command buffers for drawing the menu on another thread. debuginator_draw records into one
+// and publishes it, and the render thread takes the latest one with debuginator_acquire_draw_snapshot.
+// Neither side ever waits for the other. Set up each buffer's memory like for debuginator_set_draw_command_buffer.
+typedef struct DebuginatorDrawSnapshots {
+	DebuginatorDrawCommandBuffer buffers[3];
+	int write_index; // Only used by the thread calling debuginator_draw
+	int read_index; // Only used by the render thread
+	unsigned shared; // The buffer in between. DEBUGINATOR_DrawSnapshotFresh is set if it's newer than read_index.
+} DebuginatorDrawSnapshots;
+
+#define DEBUGINATOR_DrawSnapshotFresh 4u
+
 typedef enum DebuginatorItemEditorDataType {
 	DEBUGINATOR_EditTypeArray, // The default
 	DEBUGINATOR_EditTypeActionArray, // For items with direct actions and no state
 	DEBUGINATOR_EditTypeBoolean,
 	DEBUGINATOR_EditTypePreset,
+	DEBUGINATOR_EditTypeWatch, // Read only, shows a variable's current value
 	/*DEBUGINATOR_EditTypeUserType1,
 	...
 	DEBUGINATOR_EditTypeUserTypeN,*/
@@ -154,12 +212,58 @@ DebuginatorItem* debuginator_create_bool_item(TheDebuginator* debuginator, const
 // Useful simple callback function for setting a small value
 void debuginator_copy_1byte(DebuginatorItem* item, void* value, const char* value_title, void* app_userdata);
 
+// Targets for the atomic items below. They can be read from any thread, without locks, through
+// debuginator_atomic_*_get. Those loads pair with the release store done when the item is activated.
+typedef struct DebuginatorAtomicBool { volatile unsigned bits; } DebuginatorAtomicBool;
+typedef struct DebuginatorAtomicInt { volatile unsigned bits; } DebuginatorAtomicInt;
+typedef struct DebuginatorAtomicFloat { volatile unsigned bits; } DebuginatorAtomicFloat;
+
+// Wrap create_array_item like create_bool_item does. The target's current value picks the default value.
+DebuginatorItem* debuginator_create_atomic_bool_item(TheDebuginator* debuginator, const char* path, const char* description, DebuginatorAtomicBool* target);
+DebuginatorItem* debuginator_create_atomic_int_item(TheDebuginator* debuginator, const char* path, const char* description, DebuginatorAtomicInt* target, const char** value_titles, int* values, int num_values);
+DebuginatorItem* debuginator_create_atomic_float_item(TheDebuginator* debuginator, const char* path, const char* description, DebuginatorAtomicFloat* target, const char** value_titles, float* values, int num_values);
+
+// For enums of any underlying type; value_size can be 1, 2 or 4. 1 and 2 byte values are zero extended.
+DebuginatorItem* debuginator_create_atomic_enum_item(TheDebuginator* debuginator, const char* path, const char* description, DebuginatorAtomicInt* target, const char** value_titles, void* values, int num_values, int value_size);
+
+bool debuginator_atomic_bool_get(const DebuginatorAtomicBool* target);
+int debuginator_atomic_int_get(const DebuginatorAtomicInt* target);
+float debuginator_atomic_float_get(const DebuginatorAtomicFloat* target);
+
+// Callback used by the atomic items. Release-stores a 1, 2 or 4 byte value into the target in user_data.
+void debuginator_store_atomic(DebuginatorItem* item, void* value, const char* value_title, void* app_userdata);
+
+// Incremented, with release semantics, after every item changed callback. A thread that caches state
+// derived from debug settings can compare it against the epoch it last saw, and rebuild when it differs.
+unsigned debuginator_get_settings_epoch(TheDebuginator* debuginator);
+
 // Wraps create_array_item. Creates an item which, upon activation, sets the value of all items referenced to by paths, to
 // have the value from the corresponding index in value_titles.
 // value_indices is currently not used
 // paths and value_titles need to be of length num_paths.
 DebuginatorItem* debuginator_create_preset_item(TheDebuginator* debuginator, const char* path, const char** paths, const char** value_titles, int** value_indices, int num_paths);
 
+typedef enum DebuginatorWatchType {
+	DEBUGINATOR_WatchInt, // int
+	DEBUGINATOR_WatchFloat, // float
+	DEBUGINATOR_WatchCounter, // uint64_t
+} DebuginatorWatchType;
+
+// A read only item that shows the current value of *target to the right of its title. It's formatted
+// with format (NULL gives "%d", "%.3f" or "%llu") at most once per watch_refresh_interval (see the config),
+// and only while the item's row is drawn. target is read without synchronization and format isn't copied.
+DebuginatorItem* debuginator_create_watch_item(TheDebuginator* debuginator, const char* path, const char* description,
+	DebuginatorWatchType type, const void* target, const char* format);
+
+// Items with one value per step from min to max, without any title or value arrays. Titles are formatted
+// with format (e.g. "%d" or "%.2f", NULL gives those) only when they're needed, and values are computed.
+// The value and value_title passed to the callback point to scratch memory, copy them if you need to keep them.
+// format isn't copied and needs to outlive the item.
+DebuginatorItem* debuginator_create_int_range_item(TheDebuginator* debuginator, const char* path, const char* description,
+	DebuginatorOnItemChangedCallback on_item_changed_callback, void* user_data, int min, int max, int step, const char* format);
+DebuginatorItem* debuginator_create_float_range_item(TheDebuginator* debuginator, const char* path, const char* description,
+	DebuginatorOnItemChangedCallback on_item_changed_callback, void* user_data, float min, float max, float step, const char* format);
+
 // If you simply want to create a new folder.
 DebuginatorItem* debuginator_new_folder_item(TheDebuginator* debuginator, DebuginatorItem* parent, const char* title, int title_length);
 
@@ -179,8 +283,47 @@ DebuginatorItem* debuginator_get_hot_item(TheDebuginator* debuginator);
 // callback you pass in.
 int debuginator_save(TheDebuginator* debuginator, DebuginatorSaveItemCallback callback, char* save_buffer, int save_buffer_size);
 
-// Preload an item. If the item doesn't exist, it will be created but be hidden until properly created later.
-// value_title should be the value you want it to have when finally created.
+// Same as debuginator_save, but writes "path=value\n" lines in chunks to sink as it goes, so there's
+// no buffer to size up front and no limit on path length or depth. Only the items that differ from
+// their default are visited, most recently changed first.
+// Returns the total number of bytes written, or -1 if the sink aborted.
+int debuginator_save_stream(TheDebuginator* debuginator, DebuginatorSaveSinkCallback sink, void* userdata);
+
+// Writes "path=value\n" lines only for the items activated since the last save, for appending to a file
+// written by debuginator_save_stream. Later lines win when loading, so the file works as a journal.
+// When journal_record_count grows large, compact it by rewriting the file with debuginator_save_stream.
+// Returns the number of bytes written, or -1 if the sink aborted. The changes are kept in that case.
+int debuginator_save_changes(TheDebuginator* debuginator, DebuginatorSaveSinkCallback sink, void* userdata);
+
+// Saves the same items as debuginator_save_stream into a compact binary format keyed by path hashes
+// instead of path strings. If include_strings is true the text lines are appended for diagnostics.
+// Returns the required size. Nothing is written if buffer is NULL or smaller than that.
+int debuginator_save_binary(TheDebuginator* debuginator, void* buffer, int buffer_size, bool include_strings);
+
+// Applies a buffer written by debuginator_save_binary. The buffer is read in place and not kept, so it can be
+// a memory mapped file. Items that don't exist yet are set when created, like with debuginator_load_item.
+// Returns the number of existing items set, or -1 if it's not valid.
+int debuginator_load_binary(TheDebuginator* debuginator, const void* data, int size);
+
+// Captures the active value of every item, in the debuginator_save_binary format.
+// Returns the required size. Nothing is written if buffer is NULL or smaller than that.
+int debuginator_snapshot(TheDebuginator* debuginator, void* buffer, int buffer_size);
+
+// Activates the items whose active value differs from the snapshot, in menu order and without animations.
+// Their callbacks are called once all values are set, or left queued if callbacks are deferred, see
+// debuginator_set_deferred_callbacks. Items that have been removed since are skipped.
+// Returns the number of items changed, or -1 if it's not valid.
+int debuginator_restore(TheDebuginator* debuginator, const void* snapshot, int size);
+
+// Loads "path=value" lines, as written by debuginator_save_stream, straight from data without copying it.
+// data doesn't need to be null terminated, so it can be a memory mapped file. Both \n and \r\n line endings
+// work, and lines starting with # or ; are comments. Returns the number of entries found.
+// Like debuginator_load_item, items that don't exist yet get their values when they're created. Those are
+// kept in the memory arena, if it runs out the rest are dropped and counted in num_dropped, which can be NULL.
+int debuginator_load_from_buffer(TheDebuginator* debuginator, const char* data, int size, int* num_dropped);
+
+// Preload an item. If the item doesn't exist, the value is remembered until the item is created.
+// value_title should be the value you want it to have when finally created. It isn't kept, so it can be a temporary string.
 void debuginator_load_item(TheDebuginator* debuginator, const char* path, const char* value_title);
 
 // Set an item's default value. If value_title is NULL, value_index will be used instead.
@@ -192,6 +335,16 @@ void debuginator_set_edit_type(TheDebuginator* debuginator, const char* path, De
 // Change an item's active index to its hot index, and trigger an activation - callbacks and animations and all.
 void debuginator_activate(TheDebuginator* debuginator, DebuginatorItem* item, bool animate);
 
+// When deferred, activations don't call the items' on_item_changed_callback right away. They're queued,
+// one per item with the last value winning, until debuginator_flush_item_changed_callbacks is called.
+// That way a preset changing many items ends up as one batch of callbacks at a time of your choosing.
+// Turning it off flushes what's queued.
+void debuginator_set_deferred_callbacks(TheDebuginator* debuginator, bool deferred);
+
+// Calls the queued callbacks in the order the items were first activated. Items activated by the
+// callbacks, like a preset's, are flushed as well. Returns the number of callbacks called.
+int debuginator_flush_item_changed_callbacks(TheDebuginator* debuginator);
+
 // Navigation functions
 // Moves the hot item or hot index to the next/previous visible item or index.
 // If long_move is true, it will move to the next item that either has a different parent
@@ -214,6 +367,48 @@ void debuginator_set_filtering_enabled(TheDebuginator* debuginator, bool enabled
 const char* debuginator_get_filter(TheDebuginator* debuginator);
 void debuginator_update_filter(TheDebuginator* debuginator, const char* wanted_filter);
 
+// Makes debuginator_draw write packed commands into command_buffer instead of calling the
+// draw_rect and draw_text callbacks. Pass NULL to go back to using the callbacks.
+void debuginator_set_draw_command_buffer(TheDebuginator* debuginator, DebuginatorDrawCommandBuffer* command_buffer);
+
+// Makes debuginator_draw record into snapshots and publish each frame that changed, for drawing on
+// another thread. Call before the render thread starts using it. Pass NULL to turn it off.
+void debuginator_set_draw_snapshots(TheDebuginator* debuginator, DebuginatorDrawSnapshots* snapshots);
+
+// For the render thread. Returns the most recently published frame, or the same one as last time if
+// there's no new one. Draw it with debuginator_submit_draw_commands. It stays valid until the next call.
+const DebuginatorDrawCommandBuffer* debuginator_acquire_draw_snapshot(DebuginatorDrawSnapshots* snapshots);
+
+// Returns the null terminated text of a DEBUGINATOR_DrawCommandText command.
+const char* debuginator_get_draw_command_text(const DebuginatorDrawCommandBuffer* command_buffer, const DebuginatorDrawCommand* command);
+
+// Calls the draw_rect and draw_text callbacks for each command in the buffer, in order.
+void debuginator_submit_draw_commands(TheDebuginator* debuginator, const DebuginatorDrawCommandBuffer* command_buffer);
+
+// Draws via the callbacks or into the command buffer, whichever is active.
+// Use these in custom quick_draw and expanded_draw functions.
+void debuginator_draw_text(TheDebuginator* debuginator, const char* text, DebuginatorVector2* position, DebuginatorColor* color, DebuginatorFont* font);
+void debuginator_draw_rect(TheDebuginator* debuginator, DebuginatorVector2* position, DebuginatorVector2* size, DebuginatorColor* color);
+
+// Thread safe versions of create_array_item, remove_item_by_path, setting an item's value by title and
+// setting an item's description, for use from other threads. The commands are run in order on the thread
+// that calls debuginator_update, at most commands_per_update per frame (see the config).
+// The strings are copied. value_titles, values and user_data are used as is, like in create_array_item.
+// Returns false if the queue is disabled or full, or if the strings don't fit in DEBUGINATOR_queued_strings_size.
+bool debuginator_queue_create_item(TheDebuginator* debuginator, const char* path, const char* description,
+	DebuginatorOnItemChangedCallback on_item_changed_callback, void* user_data,
+	const char** value_titles, void* values, int num_values, int value_size);
+bool debuginator_queue_remove_item(TheDebuginator* debuginator, const char* path);
+bool debuginator_queue_set_value(TheDebuginator* debuginator, const char* path, const char* value_title);
+bool debuginator_queue_set_description(TheDebuginator* debuginator, const char* path, const char* description);
+
+// Returns true if the next debuginator_draw would draw something different from the last one.
+// Use it to skip redrawing the menu when you keep the last drawn frame around, e.g. in a render target.
+// If you change something that's displayed without going through the API, such as the contents of a
+// value title, call debuginator_request_redraw.
+bool debuginator_needs_redraw(TheDebuginator* debuginator);
+void debuginator_request_redraw(TheDebuginator* debuginator);
+
 // Sets the height of all items. Default 30.
 void debuginator_set_item_height(TheDebuginator* debuginator, int item_height);
 
@@ -269,6 +464,25 @@ typedef struct DebuginatorLeafData {
 
 	// If the item is expanded (opened).
 	bool is_expanded;
+
+	// Items activated since the last save, see debuginator_save_changes.
+	bool is_dirty;
+	DebuginatorItem* next_dirty;
+
+	// Items whose active value differs from the default, see debuginator_save_stream.
+	bool is_overridden;
+	DebuginatorItem* next_overridden;
+
+	// For finding values by title in items with many values. Built on the first lookup.
+	struct DebuginatorValueTitleIndex* value_title_index;
+
+	// Set for range items, see debuginator_create_int_range_item. values and value_titles are NULL then.
+	struct DebuginatorRange* range;
+
+	// Activations waiting for debuginator_flush_item_changed_callbacks, see debuginator_set_deferred_callbacks.
+	bool has_deferred_callback;
+	int deferred_index; // -1 for items without values
+	DebuginatorItem* next_deferred;
 } DebuginatorLeafData;
 
 typedef enum DebuginatorAnimationType {
@@ -365,6 +579,33 @@ typedef struct TheDebuginatorConfig {
 
 	// The height of each item.
 	int item_height;
+
+	// If the hot item's title should pulse. Turn it off if you cache the drawn menu between
+	// frames (see debuginator_needs_redraw), otherwise it will need to be redrawn all the time.
+	bool hot_item_pulse;
+
+	// How many activation animations can run at the same time. When full, the one closest
+	// to finishing is replaced. Allocated from the memory arena. Default 64.
+	int animation_capacity;
+
+	// How many commands the thread safe queue holds, see debuginator_queue_create_item.
+	// Rounded up to a power of two. Allocated from the memory arena, roughly 560 bytes per command.
+	// Default 0, which disables the queue; the debuginator_queue_* functions then return false.
+	int command_queue_capacity;
+
+	// How many queued commands debuginator_update runs per call. Default 64.
+	int commands_per_update;
+
+	// Optional. Lets The Debuginator spread the scoring in debuginator_update_filter over your job system.
+	// Filtering gives the same result with or without it.
+	DebuginatorParallelForCallback parallel_for;
+
+	// How often, in seconds, watch items format their values while the menu is open. Default 0.25.
+	float watch_refresh_interval;
+
+	// How many leaves each parallel_for call scores. Only used with parallel_for. Each leaf takes
+	// sizeof(DebuginatorFilterLeaf) plus 64 bytes of path storage from the memory arena. Default 1024.
+	int filter_batch_size;
 } TheDebuginatorConfig;
 
 
@@ -415,6 +656,16 @@ typedef struct TheDebuginatorConfig {
 #define DEBUGINATOR_strncpy_s strncpy_s
 #endif
 
+#ifndef DEBUGINATOR_snprintf
+#include <stdio.h>
+#define DEBUGINATOR_snprintf snprintf
+#endif
+
+#ifndef DEBUGINATOR_strtod
+#include <stdlib.h>
+#define DEBUGINATOR_strtod strtod
+#endif
+
 #ifndef DEBUGINATOR_tolower
 #include <ctype.h>
 #define DEBUGINATOR_tolower tolower
@@ -445,6 +696,37 @@ typedef struct TheDebuginatorConfig {
 #include <stdbool.h>
 #endif
 
+#include <stdint.h>
+
+// Used by the thread safe command queue and the draw snapshots, on unsigned ints. Must be overridden together.
+// load has acquire semantics, store has release semantics, exchange returns the old value.
+// load is a plain read, so readers polling the same value don't contend for its cache line.
+#ifndef DEBUGINATOR_atomic_load
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define DEBUGINATOR_atomic_load(ptr) debuginator__atomic_load_acquire(ptr)
+__forceinline unsigned debuginator__atomic_load_acquire(const volatile void* ptr) {
+	unsigned value = (unsigned)__iso_volatile_load32((const volatile __int32*)ptr);
+#if defined(_M_ARM64)
+	__dmb(_ARM64_BARRIER_ISH);
+#elif defined(_M_ARM)
+	__dmb(_ARM_BARRIER_ISH);
+#else
+	_ReadWriteBarrier(); // x86 loads already have acquire semantics, only the compiler mustn't reorder
+#endif
+	return value;
+}
+#define DEBUGINATOR_atomic_store(ptr, value) _InterlockedExchange((volatile long*)(ptr), (long)(value))
+#define DEBUGINATOR_atomic_exchange(ptr, value) ((unsigned)_InterlockedExchange((volatile long*)(ptr), (long)(value)))
+#define DEBUGINATOR_atomic_cas(ptr, expected, desired) (_InterlockedCompareExchange((volatile long*)(ptr), (long)(desired), (long)(expected)) == (long)(expected))
+#else
+#define DEBUGINATOR_atomic_load(ptr) __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+#define DEBUGINATOR_atomic_store(ptr, value) __atomic_store_n((ptr), (value), __ATOMIC_RELEASE)
+#define DEBUGINATOR_atomic_exchange(ptr, value) __atomic_exchange_n((ptr), (value), __ATOMIC_ACQ_REL)
+#define DEBUGINATOR_atomic_cas(ptr, expected, desired) __sync_bool_compare_and_swap((ptr), (expected), (desired))
+#endif
+#endif
+
 typedef struct DebuginatorBlockAllocator DebuginatorBlockAllocator;
 
 typedef struct DebuginatorBlockAllocatorStaticData {
@@ -483,8 +765,8 @@ void debuginator__block_allocator_init(DebuginatorBlockAllocator* allocator, int
 
 void* debuginator__block_allocate(DebuginatorBlockAllocator* allocator, int num_bytes) {
 	(void)num_bytes;
-	if (allocator->data->block_capacity - allocator->current_block_size < num_bytes) {
-		if (allocator->data->arena_end < allocator->data->next_free_block) {
+	if (allocator->next_free_slot == NULL && allocator->data->block_capacity - allocator->current_block_size < num_bytes) {
+		if (allocator->data->arena_end - allocator->data->next_free_block < allocator->data->block_capacity) {
 			return NULL;
 		}
 
@@ -492,7 +774,7 @@ void* debuginator__block_allocate(DebuginatorBlockAllocator* allocator, int num_
 		allocator->current_block_size = sizeof(DebuginatorBlockAllocator*); // Make room for allocator ptr at start of block
 		allocator->current_block = allocator->data->next_free_block;
 		allocator->data->next_free_block += allocator->data->block_capacity;
-		DEBUGINATOR_assert(allocator->data->arena_end > allocator->data->next_free_block);
+		DEBUGINATOR_assert(allocator->data->arena_end >= allocator->data->next_free_block);
 		*((DebuginatorBlockAllocator**)allocator->current_block) = allocator;
 		allocator->stat_wasted_block_space += sizeof(DebuginatorBlockAllocator*);
 		allocator->stat_num_blocks++;
@@ -540,8 +822,144 @@ typedef struct DebuginatorAnimation {
 
 	float duration;
 	float time;
+
+	// Where the animation ends up, recalculated when the layout changes
+	int target_distance;
+	int target_hot_index;
+	unsigned target_generation;
 } DebuginatorAnimation;
 
+#ifndef DEBUGINATOR_word_wrap_cache_size
+#define DEBUGINATOR_word_wrap_cache_size 8
+#endif
+
+#ifndef DEBUGINATOR_max_description_rows
+#define DEBUGINATOR_max_description_rows 32
+#endif
+
+#ifndef DEBUGINATOR_save_chunk_size
+#define DEBUGINATOR_save_chunk_size 1024
+#endif
+
+// Items with at least this many values get a hash index for finding values by title.
+#ifndef DEBUGINATOR_value_title_index_threshold
+#define DEBUGINATOR_value_title_index_threshold 16
+#endif
+
+// Room for the path and the description or value title of a queued command.
+#ifndef DEBUGINATOR_queued_strings_size
+#define DEBUGINATOR_queued_strings_size 512
+#endif
+
+// Must be a power of two.
+#ifndef DEBUGINATOR_pending_load_buckets
+#define DEBUGINATOR_pending_load_buckets 512
+#endif
+
+// Average path length budgeted per leaf when batching leaves for filtering. Longer paths are fine,
+// they just make a batch hold fewer leaves.
+#ifndef DEBUGINATOR_filter_path_budget
+#define DEBUGINATOR_filter_path_budget 64
+#endif
+
+typedef struct DebuginatorValueTitleSlot {
+	uint32_t hash;
+	int index_plus_one; // 0 if the slot is empty
+} DebuginatorValueTitleSlot;
+
+// An open addressing hash table from value title hash to value index. The slots are split into
+// pages so every allocation fits in the block allocators, which limits it to ~7500 values.
+#define DEBUGINATOR__VALUE_TITLE_SLOTS_PER_PAGE (1000 / (int)sizeof(DebuginatorValueTitleSlot))
+#define DEBUGINATOR__VALUE_TITLE_MAX_PAGES ((1000 - 2 * (int)sizeof(int)) / (int)sizeof(DebuginatorValueTitleSlot*))
+typedef struct DebuginatorValueTitleIndex {
+	int slot_count;
+	int page_count;
+	DebuginatorValueTitleSlot* pages[DEBUGINATOR__VALUE_TITLE_MAX_PAGES];
+} DebuginatorValueTitleIndex;
+
+typedef enum DebuginatorQueuedCommandType {
+	DEBUGINATOR_QueuedCreateItem,
+	DEBUGINATOR_QueuedRemoveItem,
+	DEBUGINATOR_QueuedSetValue,
+	DEBUGINATOR_QueuedSetDescription,
+} DebuginatorQueuedCommandType;
+
+// The create_array_item parameters that aren't strings.
+typedef struct DebuginatorQueuedItemData {
+	DebuginatorOnItemChangedCallback on_item_changed_callback;
+	void* user_data;
+	const char** value_titles;
+	void* values;
+	int num_values;
+	int value_size;
+} DebuginatorQueuedItemData;
+
+typedef struct DebuginatorQueuedCommand {
+	unsigned sequence; // See debuginator__queue_claim
+	DebuginatorQueuedCommandType type;
+	DebuginatorQueuedItemData item_data;
+	int text_offset; // Where the description or value title starts in strings, after the path. -1 if none.
+	char strings[DEBUGINATOR_queued_strings_size];
+} DebuginatorQueuedCommand;
+
+// A loaded value for an item that hasn't been created yet.
+typedef struct DebuginatorPendingLoad {
+	uint64_t path_hash;
+	uint32_t value_title_hash;
+	uint32_t value_index; // Used if no value has the title, ~0u if unknown.
+	struct DebuginatorPendingLoad* next;
+} DebuginatorPendingLoad;
+
+// The result of word wrapping an item's description. Each row is stored null terminated
+// in text, so it can be passed straight to draw_text.
+typedef struct DebuginatorWordWrapCacheEntry {
+	// Key
+	DebuginatorItem* item;
+	const char* description;
+	float width;
+	DebuginatorFont font;
+
+	// Result
+	unsigned row_count;
+	unsigned row_offsets[DEBUGINATOR_max_description_rows];
+	char text[1024];
+} DebuginatorWordWrapCacheEntry;
+
+// Stored in a watch item's values, it has no values of its own.
+typedef struct DebuginatorWatch {
+	DebuginatorWatchType type;
+	unsigned generation; // The watch_generation text was formatted in
+	const void* target;
+	const char* format;
+	char text[32];
+} DebuginatorWatch;
+
+typedef struct DebuginatorRange {
+	bool is_float;
+	int int_min;
+	int int_step;
+	float float_min;
+	float float_step;
+	const char* format;
+	union {
+		int int_value;
+		float float_value;
+	} value; // What the value passed to the item changed callback points at.
+} DebuginatorRange;
+
+#define DEBUGINATOR__RANGE_TITLE_COUNT 4
+#define DEBUGINATOR__RANGE_TITLE_SIZE 32
+
+// A leaf waiting to be scored by debuginator_update_filter. The path is lower cased by the scoring.
+typedef struct DebuginatorFilterLeaf {
+	DebuginatorItem* item;
+	int path_offset;
+	int path_length;
+	int title_start;
+	int score;
+	bool is_filtered;
+} DebuginatorFilterLeaf;
+
 typedef struct TheDebuginator {
 	DebuginatorItem* root;
 	DebuginatorItem* hot_item;
@@ -565,7 +983,27 @@ typedef struct TheDebuginator {
 	DebuginatorWordWrapCallback word_wrap;
 	DebuginatorTextSizeCallback text_size;
 	DebuginatorOnOpenChangedCallback on_opened_changed;
+	DebuginatorDrawCommandBuffer* command_buffer;
+	DebuginatorDrawSnapshots* draw_snapshots;
+	volatile unsigned settings_epoch;
 	int item_height;
+	bool hot_item_pulse;
+
+	// Bumped whenever the tree, the items' heights or their visibility change.
+	unsigned layout_generation;
+
+	// Bumped when something changes that only affects how items look, like their values.
+	unsigned redraw_generation;
+
+	// See debuginator__hot_item_distance
+	DebuginatorItem* hot_item_distance_item;
+	int hot_item_distance_hot_index;
+	unsigned hot_item_distance_generation;
+	int hot_item_distance;
+
+	// What was drawn last, see debuginator_needs_redraw.
+	uint64_t drawn_frame_signature;
+	bool drawn_frame_animating;
 
 	DebuginatorVector2 size;
 	DebuginatorVector2 root_position; // The fixed position where The Debuginator is when it's closed
@@ -575,13 +1013,58 @@ typedef struct TheDebuginator {
 	float focus_height;
 	float current_height_offset;
 
-	DebuginatorAnimation animations[8];
+	DebuginatorAnimation* animations;
+	int animation_capacity;
 	int animation_count;
 
+	DebuginatorWordWrapCacheEntry word_wrap_cache[DEBUGINATOR_word_wrap_cache_size];
+	int word_wrap_cache_next;
+
+	DebuginatorPendingLoad** pending_loads; // DEBUGINATOR_pending_load_buckets chained buckets
+	int pending_load_count;
+
+	// Bounded multi producer, single consumer queue. The positions only ever increase.
+	DebuginatorQueuedCommand* command_queue;
+	unsigned command_queue_capacity;
+	unsigned command_queue_enqueue_pos;
+	unsigned command_queue_dequeue_pos;
+	int commands_per_update;
+
+	bool defer_callbacks;
+	DebuginatorItem* first_deferred_item;
+	DebuginatorItem* last_deferred_item;
+
+	DebuginatorItem* first_dirty_item;
+	DebuginatorItem* first_overridden_item;
+	int journal_record_count; // Records written by debuginator_save_changes since the last full save
+
 	bool filter_enabled;
 	char filter[32];
 	int filter_length;
 
+	DebuginatorParallelForCallback parallel_for;
+	DebuginatorFilterLeaf* filter_batch_leaves;
+	char* filter_batch_paths;
+	int filter_batch_size;
+
+	// Watch items are reformatted when watch_generation changes, every watch_refresh_interval.
+	int watch_item_count;
+	float watch_refresh_interval;
+	float watch_timer;
+	unsigned watch_generation;
+
+	// Formatted titles of range items, used round robin so a few can be alive at once.
+	char range_titles[DEBUGINATOR__RANGE_TITLE_COUNT][DEBUGINATOR__RANGE_TITLE_SIZE];
+	int range_title_next;
+
+	// Values of the items The Debuginator creates itself. Per instance, so instances share no state.
+	bool bool_values[2];
+	const char* bool_titles[2];
+	char direction_values[2];
+	const char* direction_titles[2];
+	int theme_values[4];
+	const char* theme_titles[4];
+
 	char* memory_arena; // char* for pointer arithmetic
 	int memory_arena_capacity;
 	DebuginatorBlockAllocatorStaticData allocator_data;
@@ -614,6 +1097,225 @@ float debuginator__lerp(float a, float b, float t) {
 	return a * (1 - t) + b * t;
 }
 
+// 64 bit FNV-1a
+uint64_t debuginator__hash_bytes(uint64_t hash, const void* data, int size) {
+	const unsigned char* bytes = (const unsigned char*)data;
+	for (int i = 0; i < size; i++) {
+		hash ^= bytes[i];
+		hash *= 0x100000001b3ull;
+	}
+
+	return hash;
+}
+
+#define DEBUGINATOR__HASH_SEED 0xcbf29ce484222325ull
+
+// A path hash is the hash of the full "a/b/c" path, built one title at a time.
+uint64_t debuginator__child_path_hash(DebuginatorItem* item, uint64_t parent_path_hash) {
+	uint64_t hash = parent_path_hash;
+	if (item->parent != NULL && item->parent->parent != NULL) {
+		hash = debuginator__hash_bytes(hash, "/", 1);
+	}
+
+	return debuginator__hash_bytes(hash, item->title, (int)DEBUGINATOR_strlen(item->title));
+}
+
+uint32_t debuginator__value_title_hash(const char* value_title, int length) {
+	uint64_t hash = debuginator__hash_bytes(DEBUGINATOR__HASH_SEED, value_title, length);
+	return (uint32_t)(hash ^ (hash >> 32));
+}
+
+uint64_t debuginator__item_path_hash(DebuginatorItem* item) {
+	if (item->parent == NULL) {
+		return DEBUGINATOR__HASH_SEED;
+	}
+
+	return debuginator__child_path_hash(item, debuginator__item_path_hash(item->parent));
+}
+
+void debuginator__invalidate_layout(TheDebuginator* debuginator) {
+	debuginator->layout_generation++;
+}
+
+DebuginatorDrawCommand* debuginator__push_draw_command(DebuginatorDrawCommandBuffer* command_buffer, DebuginatorDrawCommandType type) {
+	if (command_buffer->command_count == command_buffer->command_capacity) {
+		command_buffer->overflowed = true;
+		return NULL;
+	}
+
+	DebuginatorDrawCommand* command = &command_buffer->commands[command_buffer->command_count++];
+	command->type = type;
+	return command;
+}
+
+void debuginator_draw_text(TheDebuginator* debuginator, const char* text, DebuginatorVector2* position, DebuginatorColor* color, DebuginatorFont* font) {
+	DebuginatorDrawCommandBuffer* command_buffer = debuginator->command_buffer;
+	if (command_buffer == NULL) {
+		debuginator->draw_text(text, position, color, font, debuginator->app_user_data);
+		return;
+	}
+
+	int length = (int)DEBUGINATOR_strlen(text);
+	if (command_buffer->string_pool_capacity - command_buffer->string_pool_size < length + 1) {
+		command_buffer->overflowed = true;
+		return;
+	}
+
+	DebuginatorDrawCommand* command = debuginator__push_draw_command(command_buffer, DEBUGINATOR_DrawCommandText);
+	if (command == NULL) {
+		return;
+	}
+
+	command->position = *position;
+	command->color = *color;
+	command->data.text.offset = command_buffer->string_pool_size;
+	command->data.text.length = length;
+	command->data.text.font = *font;
+	DEBUGINATOR_memcpy(command_buffer->string_pool + command_buffer->string_pool_size, text, length + 1);
+	command_buffer->string_pool_size += length + 1;
+}
+
+void debuginator_draw_rect(TheDebuginator* debuginator, DebuginatorVector2* position, DebuginatorVector2* size, DebuginatorColor* color) {
+	if (debuginator->command_buffer == NULL) {
+		debuginator->draw_rect(position, size, color, debuginator->app_user_data);
+		return;
+	}
+
+	DebuginatorDrawCommand* command = debuginator__push_draw_command(debuginator->command_buffer, DEBUGINATOR_DrawCommandRect);
+	if (command == NULL) {
+		return;
+	}
+
+	command->position = *position;
+	command->color = *color;
+	command->data.rect.size = *size;
+}
+
+void debuginator_set_draw_command_buffer(TheDebuginator* debuginator, DebuginatorDrawCommandBuffer* command_buffer) {
+	debuginator->command_buffer = command_buffer;
+}
+
+void debuginator_set_draw_snapshots(TheDebuginator* debuginator, DebuginatorDrawSnapshots* snapshots) {
+	debuginator->draw_snapshots = snapshots;
+	debuginator->command_buffer = NULL;
+	if (snapshots == NULL) {
+		return;
+	}
+
+	for (int i = 0; i < 3; i++) {
+		snapshots->buffers[i].command_count = 0;
+		snapshots->buffers[i].string_pool_size = 0;
+		snapshots->buffers[i].overflowed = false;
+	}
+
+	snapshots->write_index = 0;
+	snapshots->shared = 1;
+	snapshots->read_index = 2;
+
+	// Make sure the first frame is published.
+	debuginator_request_redraw(debuginator);
+}
+
+// The writer and the reader each own one buffer and swap it with the shared one, so they never touch the same buffer.
+void debuginator__publish_draw_snapshot(DebuginatorDrawSnapshots* snapshots) {
+	unsigned previous = DEBUGINATOR_atomic_exchange(&snapshots->shared, (unsigned)snapshots->write_index | DEBUGINATOR_DrawSnapshotFresh);
+	snapshots->write_index = (int)(previous & ~DEBUGINATOR_DrawSnapshotFresh);
+}
+
+const DebuginatorDrawCommandBuffer* debuginator_acquire_draw_snapshot(DebuginatorDrawSnapshots* snapshots) {
+	if (DEBUGINATOR_atomic_load(&snapshots->shared) & DEBUGINATOR_DrawSnapshotFresh) {
+		unsigned previous = DEBUGINATOR_atomic_exchange(&snapshots->shared, (unsigned)snapshots->read_index);
+		snapshots->read_index = (int)(previous & ~DEBUGINATOR_DrawSnapshotFresh);
+	}
+
+	return &snapshots->buffers[snapshots->read_index];
+}
+
+const char* debuginator_get_draw_command_text(const DebuginatorDrawCommandBuffer* command_buffer, const DebuginatorDrawCommand* command) {
+	DEBUGINATOR_assert(command->type == DEBUGINATOR_DrawCommandText);
+	return command_buffer->string_pool + command->data.text.offset;
+}
+
+void debuginator_submit_draw_commands(TheDebuginator* debuginator, const DebuginatorDrawCommandBuffer* command_buffer) {
+	for (int i = 0; i < command_buffer->command_count; i++) {
+		// The callbacks take non-const pointers, so give them copies.
+		DebuginatorDrawCommand command = command_buffer->commands[i];
+		if (command.type == DEBUGINATOR_DrawCommandRect) {
+			debuginator->draw_rect(&command.position, &command.data.rect.size, &command.color, debuginator->app_user_data);
+		}
+		else {
+			const char* text = debuginator_get_draw_command_text(command_buffer, &command);
+			debuginator->draw_text(text, &command.position, &command.color, &command.data.text.font, debuginator->app_user_data);
+		}
+	}
+}
+
+// Range items have no title or value arrays, so these make them when they're needed.
+const char* debuginator__value_title(TheDebuginator* debuginator, DebuginatorItem* item, int index) {
+	DebuginatorRange* range = item->leaf.range;
+	if (range == NULL) {
+		return item->leaf.value_titles[index];
+	}
+
+	char* title = debuginator->range_titles[debuginator->range_title_next];
+	debuginator->range_title_next = (debuginator->range_title_next + 1) % DEBUGINATOR__RANGE_TITLE_COUNT;
+	if (range->is_float) {
+		DEBUGINATOR_snprintf(title, DEBUGINATOR__RANGE_TITLE_SIZE, range->format, (double)(range->float_min + index * range->float_step));
+	}
+	else {
+		DEBUGINATOR_snprintf(title, DEBUGINATOR__RANGE_TITLE_SIZE, range->format, range->int_min + index * range->int_step);
+	}
+
+	return title;
+}
+
+void* debuginator__value_pointer(DebuginatorItem* item, int index) {
+	DebuginatorRange* range = item->leaf.range;
+	if (range == NULL) {
+		return ((char*)item->leaf.values) + index * item->leaf.array_element_size;
+	}
+
+	if (range->is_float) {
+		range->value.float_value = range->float_min + index * range->float_step;
+	}
+	else {
+		range->value.int_value = range->int_min + index * range->int_step;
+	}
+
+	return &range->value;
+}
+
+// Finds a range item's value by parsing its title, or returns -1. Formats with text before the
+// number are handled by skipping it. The title of the found value must match exactly.
+int debuginator__range_index_from_title(TheDebuginator* debuginator, DebuginatorItem* item, const char* value_title) {
+	DebuginatorRange* range = item->leaf.range;
+	const char* number = value_title;
+	const char* format = range->format;
+	while (*format != '\0' && *format != '%' && *number == *format) {
+		number++;
+		format++;
+	}
+
+	char* number_end;
+	double value = DEBUGINATOR_strtod(number, &number_end);
+	if (number_end == number) {
+		return -1;
+	}
+
+	double step = range->is_float ? range->float_step : range->int_step;
+	double min = range->is_float ? range->float_min : range->int_min;
+	double index = (value - min) / step + 0.5;
+	if (index < 0 || index >= item->leaf.num_values) {
+		return -1;
+	}
+
+	if (strcmp(debuginator__value_title(debuginator, item, (int)index), value_title) != 0) {
+		return -1;
+	}
+
+	return (int)index;
+}
+
 void debuginator__quick_draw_default(TheDebuginator* debuginator, DebuginatorItem* item, DebuginatorVector2* position) {
 	if (item->leaf.num_values > 0) {
 		DebuginatorVector2 pos = debuginator__vector2(debuginator->top_left.x + debuginator->size.x - 200, position->y);
@@ -622,38 +1324,56 @@ void debuginator__quick_draw_default(TheDebuginator* debuginator, DebuginatorIte
 		//value_offset.x = debuginator->openness * debuginator->size.x - 200;
 		bool is_overriden = item->leaf.active_index != item->leaf.default_index;
 		unsigned default_color_index = is_overriden ? DEBUGINATOR_ItemTitleOverridden : DEBUGINATOR_ItemTitle;
-		debuginator->draw_text(item->leaf.value_titles[item->leaf.active_index], &pos, &debuginator->theme.colors[default_color_index], &debuginator->theme.fonts[DEBUGINATOR_ItemTitle], debuginator->app_user_data);
+		debuginator_draw_text(debuginator, debuginator__value_title(debuginator, item, item->leaf.active_index), &pos, &debuginator->theme.colors[default_color_index], &debuginator->theme.fonts[DEBUGINATOR_ItemTitle]);
 	}
 }
 
+// Value rows of an expanded item that can be on screen, given that row i is drawn at
+// start_y + (i + 1) * item_height. Rows are conservatively included if they're close.
+void debuginator__visible_value_rows(TheDebuginator* debuginator, DebuginatorItem* item, float start_y, int* first_row, int* end_row) {
+	float item_height = (float)debuginator->item_height;
+	int first = (int)(-start_y / item_height) - 2;
+	int end = (int)((debuginator->size.y - start_y) / item_height) + 1;
+	*first_row = first < 0 ? 0 : first;
+	*end_row = end > item->leaf.num_values ? item->leaf.num_values : end;
+}
+
 void debuginator__expanded_draw_default(TheDebuginator* debuginator, DebuginatorItem* item, DebuginatorVector2* position) {
-	for (size_t i = 0; i < item->leaf.num_values; i++) {
-		position->y += debuginator->item_height;
+	float start_y = position->y;
+	int first_row, end_row;
+	debuginator__visible_value_rows(debuginator, item, start_y, &first_row, &end_row);
+	for (int i = first_row; i < end_row; i++) {
+		position->y = start_y + (i + 1) * debuginator->item_height;
 
 		if (debuginator->hot_item == item && item->leaf.hot_index == i) {
 			DebuginatorVector2 pos = debuginator__vector2(debuginator->top_left.x, position->y - 5);
 			DebuginatorVector2 size = debuginator__vector2(500.f, (float)debuginator->item_height);
-			debuginator->draw_rect(&pos, &size, &debuginator->theme.colors[DEBUGINATOR_LineHighlight], debuginator->app_user_data);
+			debuginator_draw_rect(debuginator, &pos, &size, &debuginator->theme.colors[DEBUGINATOR_LineHighlight]);
 		}
 
-		const char* value_title = item->leaf.value_titles[i];
+		const char* value_title = debuginator__value_title(debuginator, item, i);
 		bool value_hot = i == item->leaf.hot_index;
 		bool value_overridden = i == item->leaf.active_index;
 		unsigned value_color_index = value_hot ? DEBUGINATOR_ItemValueHot : (value_overridden ? DEBUGINATOR_ItemTitleOverridden : DEBUGINATOR_ItemValueDefault);
-		debuginator->draw_text(value_title, position, &debuginator->theme.colors[value_color_index], &debuginator->theme.fonts[value_hot ? DEBUGINATOR_ItemTitleHot : DEBUGINATOR_ItemTitle], debuginator->app_user_data);
+		debuginator_draw_text(debuginator, value_title, position, &debuginator->theme.colors[value_color_index], &debuginator->theme.fonts[value_hot ? DEBUGINATOR_ItemTitleHot : DEBUGINATOR_ItemTitle]);
 	}
+
+	position->y = start_y + item->leaf.num_values * debuginator->item_height;
 }
 
 void debuginator__quick_draw_boolean(TheDebuginator* debuginator, DebuginatorItem* item, DebuginatorVector2* position) {
 	DebuginatorVector2 pos = debuginator__vector2(debuginator->top_left.x + debuginator->size.x - 200, position->y);
 	DebuginatorVector2 size = debuginator__vector2(50, 20);
 	DebuginatorColor background = debuginator__color(0, 0, 0, 100);
-	debuginator->draw_rect(&pos, &size, &background, debuginator->app_user_data);
+	debuginator_draw_rect(debuginator, &pos, &size, &background);
 
 	item->leaf.draw_t += debuginator->dt * 5;
 	if (item->leaf.draw_t > 1) {
 		item->leaf.draw_t = 1;
 	}
+	else {
+		debuginator->drawn_frame_animating = true;
+	}
 
 	DebuginatorVector2 slider_pos = pos;
 	if (item->leaf.active_index == 0) {
@@ -672,25 +1392,50 @@ void debuginator__quick_draw_boolean(TheDebuginator* debuginator, DebuginatorIte
 	DebuginatorColor slider = item->leaf.active_index == 0 ? debuginator->theme.colors[DEBUGINATOR_ItemEditorOff] : debuginator->theme.colors[DEBUGINATOR_ItemEditorOn];
 	slider.a = alpha;
 
-	debuginator->draw_rect(&slider_pos, &size, &slider, debuginator->app_user_data);
+	debuginator_draw_rect(debuginator, &slider_pos, &size, &slider);
 }
 
 void debuginator__expanded_draw_boolean(TheDebuginator* debuginator, DebuginatorItem* item, DebuginatorVector2* position) {
-	for (size_t i = 0; i < item->leaf.num_values; i++) {
-		position->y += debuginator->item_height;
+	float start_y = position->y;
+	int first_row, end_row;
+	debuginator__visible_value_rows(debuginator, item, start_y, &first_row, &end_row);
+	for (int i = first_row; i < end_row; i++) {
+		position->y = start_y + (i + 1) * debuginator->item_height;
 
 		if (debuginator->hot_item == item && item->leaf.hot_index == i) {
 			DebuginatorVector2 pos = debuginator__vector2(debuginator->top_left.x, position->y - 5);
 			DebuginatorVector2 size = debuginator__vector2(500, (float)debuginator->item_height);
-			debuginator->draw_rect(&pos, &size, &debuginator->theme.colors[DEBUGINATOR_LineHighlight], debuginator->app_user_data);
+			debuginator_draw_rect(debuginator, &pos, &size, &debuginator->theme.colors[DEBUGINATOR_LineHighlight]);
 		}
 
-		const char* value_title = item->leaf.value_titles[i];
+		const char* value_title = debuginator__value_title(debuginator, item, i);
 		bool value_hot = i == item->leaf.hot_index;
 		bool value_overridden = i == item->leaf.active_index;
 		unsigned value_color_index = value_hot ? DEBUGINATOR_ItemValueHot : (value_overridden ? DEBUGINATOR_ItemTitleOverridden : DEBUGINATOR_ItemValueDefault);
-		debuginator->draw_text(value_title, position, &debuginator->theme.colors[value_color_index], &debuginator->theme.fonts[value_hot ? DEBUGINATOR_ItemTitleHot : DEBUGINATOR_ItemTitle], debuginator->app_user_data);
+		debuginator_draw_text(debuginator, value_title, position, &debuginator->theme.colors[value_color_index], &debuginator->theme.fonts[value_hot ? DEBUGINATOR_ItemTitleHot : DEBUGINATOR_ItemTitle]);
+	}
+
+	position->y = start_y + item->leaf.num_values * debuginator->item_height;
+}
+
+void debuginator__quick_draw_watch(TheDebuginator* debuginator, DebuginatorItem* item, DebuginatorVector2* position) {
+	// Only called for rows on screen, so off screen watches aren't formatted.
+	DebuginatorWatch* watch = (DebuginatorWatch*)item->leaf.values;
+	if (watch->generation != debuginator->watch_generation) {
+		watch->generation = debuginator->watch_generation;
+		if (watch->type == DEBUGINATOR_WatchInt) {
+			DEBUGINATOR_snprintf(watch->text, sizeof(watch->text), watch->format, *(const volatile int*)watch->target);
+		}
+		else if (watch->type == DEBUGINATOR_WatchFloat) {
+			DEBUGINATOR_snprintf(watch->text, sizeof(watch->text), watch->format, (double)*(const volatile float*)watch->target);
+		}
+		else {
+			DEBUGINATOR_snprintf(watch->text, sizeof(watch->text), watch->format, (unsigned long long)*(const volatile uint64_t*)watch->target);
+		}
 	}
+
+	DebuginatorVector2 pos = debuginator__vector2(debuginator->top_left.x + debuginator->size.x - 200, position->y);
+	debuginator_draw_text(debuginator, watch->text, &pos, &debuginator->theme.colors[DEBUGINATOR_ItemValueDefault], &debuginator->theme.fonts[DEBUGINATOR_ItemTitle]);
 }
 
 void debuginator__quick_draw_preset(TheDebuginator* debuginator, DebuginatorItem* item, DebuginatorVector2* position) {
@@ -698,22 +1443,29 @@ void debuginator__quick_draw_preset(TheDebuginator* debuginator, DebuginatorItem
 }
 
 void debuginator__expanded_draw_preset(TheDebuginator* debuginator, DebuginatorItem* item, DebuginatorVector2* position) {
-	for (size_t i = 0; i < item->leaf.num_values; i++) {
-		position->y += debuginator->item_height;
-		const char* value_title = item->leaf.value_titles[i];
+	float start_y = position->y;
+	int first_row, end_row;
+	debuginator__visible_value_rows(debuginator, item, start_y, &first_row, &end_row);
+	for (int i = first_row; i < end_row; i++) {
+		position->y = start_y + (i + 1) * debuginator->item_height;
+		const char* value_title = debuginator__value_title(debuginator, item, i);
 		bool value_hot = i == item->leaf.hot_index;
 		bool value_overridden = i == item->leaf.active_index;
 		unsigned value_color_index = value_hot ? DEBUGINATOR_ItemValueHot : (value_overridden ? DEBUGINATOR_ItemTitleOverridden : DEBUGINATOR_ItemValueDefault);
-		debuginator->draw_text(value_title, position, &debuginator->theme.colors[value_color_index], &debuginator->theme.fonts[value_hot ? DEBUGINATOR_ItemTitleHot : DEBUGINATOR_ItemTitle], debuginator->app_user_data);
+		debuginator_draw_text(debuginator, value_title, position, &debuginator->theme.colors[value_color_index], &debuginator->theme.fonts[value_hot ? DEBUGINATOR_ItemTitleHot : DEBUGINATOR_ItemTitle]);
 	}
+
+	position->y = start_y + item->leaf.num_values * debuginator->item_height;
 }
 
-void* debuginator__allocate(TheDebuginator* debuginator, int bytes/*, const void* origin*/) {
+// Returns NULL if the arena is full, for allocations that can fail gracefully.
+void* debuginator__try_allocate(TheDebuginator* debuginator, int bytes) {
 	for (int i = 0; i < 6; i++) {
 		if (bytes <= debuginator->allocators[i].element_size) {
 			void* result = debuginator__block_allocate(&debuginator->allocators[i], bytes);
-			DEBUGINATOR_assert(result != NULL);
-			DEBUGINATOR_memset(result, 0, bytes);
+			if (result != NULL) {
+				DEBUGINATOR_memset(result, 0, bytes);
+			}
 			return result;
 		}
 	}
@@ -722,6 +1474,12 @@ void* debuginator__allocate(TheDebuginator* debuginator, int bytes/*, const void
 	return NULL;
 }
 
+void* debuginator__allocate(TheDebuginator* debuginator, int bytes/*, const void* origin*/) {
+	void* result = debuginator__try_allocate(debuginator, bytes);
+	DEBUGINATOR_assert(result != NULL);
+	return result;
+}
+
 void debuginator__deallocate(TheDebuginator* debuginator, const void* void_ptr) {
 	// We remove the const part and that's fine, if it's our string we can do whatever we want with it,
 	// and if not, then we don't do anything (see right below). It makes the API a bit nicer.
@@ -753,94 +1511,395 @@ char* debuginator_copy_string(TheDebuginator* debuginator, const char* string, i
 	return memory;
 }
 
-DebuginatorAnimation* debuginator__get_free_animation(TheDebuginator* debuginator) {
-	if (debuginator->animation_count == sizeof(debuginator->animations) / sizeof(*debuginator->animations)) {
+// For memory that lives as long as The Debuginator does. Takes whole blocks straight from the
+// arena, so unlike debuginator__allocate it can be larger than a block. Can't be deallocated.
+void* debuginator__allocate_permanent(TheDebuginator* debuginator, int bytes) {
+	DebuginatorBlockAllocatorStaticData* data = &debuginator->allocator_data;
+	int num_blocks = (bytes + data->block_capacity - 1) / data->block_capacity;
+	if (bytes <= 0 || data->arena_end - data->next_free_block < num_blocks * data->block_capacity) {
+		DEBUGINATOR_assert(bytes <= 0);
 		return NULL;
 	}
 
-	DebuginatorAnimation* animation = &debuginator->animations[debuginator->animation_count++];
-	DEBUGINATOR_memset(animation, 0, sizeof(*animation));
-	return animation;
+	void* result = data->next_free_block;
+	data->next_free_block += num_blocks * data->block_capacity;
+	DEBUGINATOR_memset(result, 0, bytes);
+	return result;
 }
 
-void debuginator__set_total_height(DebuginatorItem* item, int height) {
-	if (item->total_height == height) {
-		return;
+// Loaded values for items that haven't been created yet, see debuginator_load_item.
+DebuginatorPendingLoad** debuginator__pending_load_bucket(TheDebuginator* debuginator, uint64_t path_hash) {
+	return &debuginator->pending_loads[(path_hash ^ (path_hash >> 32)) & (DEBUGINATOR_pending_load_buckets - 1)];
+}
+
+// Returns false if the arena is full and the load was dropped.
+bool debuginator__add_pending_load(TheDebuginator* debuginator, uint64_t path_hash, uint32_t value_title_hash, uint32_t value_index) {
+	if (debuginator->pending_loads == NULL) {
+		return false;
 	}
 
-	int diff = height - item->total_height;
-	item->total_height = height;
-	if (item->parent) {
-		debuginator__set_total_height(item->parent, item->parent->total_height + diff);
+	DebuginatorPendingLoad** bucket = debuginator__pending_load_bucket(debuginator, path_hash);
+	DebuginatorPendingLoad* pending = *bucket;
+	while (pending != NULL && pending->path_hash != path_hash) {
+		pending = pending->next;
 	}
-}
 
-int debuginator__set_item_total_height_recursively(DebuginatorItem* item, int item_height) {
-	if (item->is_folder) {
-		item->total_height = 0;
-		DebuginatorItem* child = item->folder.first_child;
-		while (child != NULL) {
-			item->total_height += debuginator__set_item_total_height_recursively(child, item_height);
-			child = child->next_sibling;
+	if (pending == NULL) {
+		pending = (DebuginatorPendingLoad*)debuginator__try_allocate(debuginator, sizeof(DebuginatorPendingLoad));
+		if (pending == NULL) {
+			return false;
 		}
 
-		if (item->total_height > 0) {
-			item->total_height += item_height;
-		}
+		pending->path_hash = path_hash;
+		pending->next = *bucket;
+		*bucket = pending;
+		debuginator->pending_load_count++;
 	}
-	else {
-		if (item->leaf.is_expanded) {
-			item->total_height = item_height + item_height + item_height * (item->leaf.num_values);
-		}
-		else if (item->leaf.hot_index != -2 && !item->is_filtered) {
-			item->total_height = item_height;
-		}
-		else {
-			item->total_height = 0;
+
+	pending->value_title_hash = value_title_hash;
+	pending->value_index = value_index;
+	return true;
+}
+
+// Removes the pending load for path_hash and returns true if there was one.
+bool debuginator__take_pending_load(TheDebuginator* debuginator, uint64_t path_hash, uint32_t* value_title_hash, uint32_t* value_index) {
+	if (debuginator->pending_load_count == 0) {
+		return false;
+	}
+
+	DebuginatorPendingLoad** link = debuginator__pending_load_bucket(debuginator, path_hash);
+	while (*link != NULL) {
+		DebuginatorPendingLoad* pending = *link;
+		if (pending->path_hash == path_hash) {
+			*value_title_hash = pending->value_title_hash;
+			*value_index = pending->value_index;
+			*link = pending->next;
+			debuginator__deallocate(debuginator, pending);
+			debuginator->pending_load_count--;
+			return true;
 		}
+
+		link = &pending->next;
 	}
 
-	return item->total_height;
+	return false;
 }
 
-void debuginator__adjust_num_visible_children(DebuginatorItem* item, int diff) {
-	DEBUGINATOR_assert(item->is_folder);
-	DEBUGINATOR_assert(diff != 0 && item->folder.num_visible_children + diff >= 0);
-	item->folder.num_visible_children += diff;
-	if (item->folder.num_visible_children == 0 && item->parent != NULL) {
-		// Hide us as well
-		debuginator__adjust_num_visible_children(item->parent, -1);
+void debuginator__drop_value_title_index(TheDebuginator* debuginator, DebuginatorItem* item) {
+	DebuginatorValueTitleIndex* index = item->leaf.value_title_index;
+	if (index == NULL) {
+		return;
 	}
-	else if (item->folder.num_visible_children == diff && item->parent != NULL) {
-		debuginator__adjust_num_visible_children(item->parent, 1);
+
+	for (int i = 0; i < index->page_count; i++) {
+		debuginator__deallocate(debuginator, index->pages[i]);
 	}
+
+	debuginator__deallocate(debuginator, index);
+	item->leaf.value_title_index = NULL;
 }
 
-void debuginator__on_change_theme(DebuginatorItem* item, void* value, const char* value_title, void* app_userdata) {
-	(void)app_userdata;
-	(void)value_title;
-	TheDebuginator* debuginator = (TheDebuginator*)item->user_data;
-	debuginator->theme_index = *(int*)value;
-	debuginator->theme = debuginator->themes[debuginator->theme_index];
+DebuginatorValueTitleSlot* debuginator__value_title_slot(DebuginatorValueTitleIndex* index, int slot) {
+	return &index->pages[slot / DEBUGINATOR__VALUE_TITLE_SLOTS_PER_PAGE][slot % DEBUGINATOR__VALUE_TITLE_SLOTS_PER_PAGE];
 }
 
-void debuginator_set_title(TheDebuginator* debuginator, DebuginatorItem* item, const char* title, int title_length) {
-	if (title_length == 0) {
-		title_length = (int)DEBUGINATOR_strlen(title);
+DebuginatorValueTitleIndex* debuginator__get_value_title_index(TheDebuginator* debuginator, DebuginatorItem* item) {
+	if (item->leaf.value_title_index != NULL) {
+		return item->leaf.value_title_index;
 	}
 
-	item->title = debuginator_copy_string(debuginator, title, title_length);
-}
+	// Half full at most, so the probes stay short.
+	int num_values = item->leaf.num_values;
+	int page_count = (num_values * 2 + DEBUGINATOR__VALUE_TITLE_SLOTS_PER_PAGE - 1) / DEBUGINATOR__VALUE_TITLE_SLOTS_PER_PAGE;
+	if (num_values < DEBUGINATOR_value_title_index_threshold || page_count > DEBUGINATOR__VALUE_TITLE_MAX_PAGES) {
+		return NULL;
+	}
 
-DebuginatorItem* debuginator__next_visible_sibling(DebuginatorItem* item) {
-	DebuginatorItem* sibling = item->next_sibling;
+	DebuginatorValueTitleIndex* index = (DebuginatorValueTitleIndex*)debuginator__allocate(debuginator, sizeof(DebuginatorValueTitleIndex));
+	index->page_count = page_count;
+	index->slot_count = page_count * DEBUGINATOR__VALUE_TITLE_SLOTS_PER_PAGE;
+	for (int i = 0; i < page_count; i++) {
+		index->pages[i] = (DebuginatorValueTitleSlot*)debuginator__allocate(debuginator, DEBUGINATOR__VALUE_TITLE_SLOTS_PER_PAGE * (int)sizeof(DebuginatorValueTitleSlot));
+	}
+
+	// Inserted backwards so the first of several equal titles ends up first in its probe sequence.
+	for (int i = num_values - 1; i >= 0; i--) {
+		const char* value_title = debuginator__value_title(debuginator, item, i);
+		uint32_t hash = debuginator__value_title_hash(value_title, (int)DEBUGINATOR_strlen(value_title));
+		int slot = (int)(hash % (uint32_t)index->slot_count);
+		while (debuginator__value_title_slot(index, slot)->index_plus_one != 0) {
+			slot = (slot + 1) % index->slot_count;
+		}
+
+		debuginator__value_title_slot(index, slot)->hash = hash;
+		debuginator__value_title_slot(index, slot)->index_plus_one = i + 1;
+	}
+
+	item->leaf.value_title_index = index;
+	return index;
+}
+
+// Returns the index of the value with the given title hash, or -1. If value_title isn't NULL
+// it's compared as well, so hash collisions don't matter.
+int debuginator__lookup_value_title(TheDebuginator* debuginator, DebuginatorItem* item, uint32_t hash, const char* value_title) {
+	if (item->leaf.range != NULL && value_title != NULL) {
+		int range_index = debuginator__range_index_from_title(debuginator, item, value_title);
+		if (range_index >= 0) {
+			return range_index;
+		}
+	}
+
+	DebuginatorValueTitleIndex* index = debuginator__get_value_title_index(debuginator, item);
+	if (index == NULL) {
+		for (int i = 0; i < item->leaf.num_values; i++) {
+			const char* title = debuginator__value_title(debuginator, item, i);
+			if (value_title != NULL ? strcmp(title, value_title) == 0 : debuginator__value_title_hash(title, (int)DEBUGINATOR_strlen(title)) == hash) {
+				return i;
+			}
+		}
+
+		return -1;
+	}
+
+	int slot = (int)(hash % (uint32_t)index->slot_count);
+	for (int probes = 0; probes < index->slot_count; probes++) {
+		DebuginatorValueTitleSlot* entry = debuginator__value_title_slot(index, slot);
+		if (entry->index_plus_one == 0) {
+			break;
+		}
+
+		if (entry->hash == hash) {
+			int value_index = entry->index_plus_one - 1;
+			if (value_title == NULL || strcmp(debuginator__value_title(debuginator, item, value_index), value_title) == 0) {
+				return value_index;
+			}
+		}
+
+		slot = (slot + 1) % index->slot_count;
+	}
+
+	return -1;
+}
+
+// Finds the value with the given title hash. The saved index is checked first since it usually
+// still matches, and is the fallback if the titles have changed. Pass ~0u if there's no index.
+int debuginator__find_value_index(TheDebuginator* debuginator, DebuginatorItem* item, uint32_t value_title_hash, uint32_t value_index) {
+	if (value_index < (uint32_t)item->leaf.num_values) {
+		const char* value_title = debuginator__value_title(debuginator, item, (int)value_index);
+		if (debuginator__value_title_hash(value_title, (int)DEBUGINATOR_strlen(value_title)) == value_title_hash) {
+			return (int)value_index;
+		}
+	}
+
+	int index = debuginator__lookup_value_title(debuginator, item, value_title_hash, NULL);
+	if (index >= 0) {
+		return index;
+	}
+
+	return value_index < (uint32_t)item->leaf.num_values ? (int)value_index : -1;
+}
+
+int debuginator__find_value_by_title(TheDebuginator* debuginator, DebuginatorItem* item, const char* value_title) {
+	return debuginator__lookup_value_title(debuginator, item, debuginator__value_title_hash(value_title, (int)DEBUGINATOR_strlen(value_title)), value_title);
+}
+
+DebuginatorAnimation* debuginator__get_free_animation(TheDebuginator* debuginator) {
+	if (debuginator->animation_capacity == 0) {
+		return NULL;
+	}
+
+	DebuginatorAnimation* animation = NULL;
+	if (debuginator->animation_count < debuginator->animation_capacity) {
+		animation = &debuginator->animations[debuginator->animation_count++];
+	}
+	else {
+		animation = &debuginator->animations[0];
+		for (int i = 1; i < debuginator->animation_count; i++) {
+			if (debuginator->animations[i].duration - debuginator->animations[i].time < animation->duration - animation->time) {
+				animation = &debuginator->animations[i];
+			}
+		}
+	}
+
+	DEBUGINATOR_memset(animation, 0, sizeof(*animation));
+	return animation;
+}
+
+void debuginator__remove_animations(TheDebuginator* debuginator, DebuginatorItem* item) {
+	for (int i = 0; i < debuginator->animation_count;) {
+		if (debuginator->animations[i].data.item_activate.item == item) {
+			debuginator->animations[i] = debuginator->animations[--debuginator->animation_count];
+		}
+		else {
+			++i;
+		}
+	}
+}
+
+// Any change in height moves the items below, so it invalidates the layout.
+void debuginator__set_total_height(TheDebuginator* debuginator, DebuginatorItem* item, int height) {
+	if (item->total_height == height) {
+		return;
+	}
+
+	int diff = height - item->total_height;
+	item->total_height = height;
+	debuginator__invalidate_layout(debuginator);
+	if (item->parent) {
+		debuginator__set_total_height(debuginator, item->parent, item->parent->total_height + diff);
+	}
+}
+
+int debuginator__set_item_total_height_recursively(DebuginatorItem* item, int item_height) {
+	if (item->is_folder) {
+		item->total_height = 0;
+		DebuginatorItem* child = item->folder.first_child;
+		while (child != NULL) {
+			item->total_height += debuginator__set_item_total_height_recursively(child, item_height);
+			child = child->next_sibling;
+		}
+
+		if (item->total_height > 0) {
+			item->total_height += item_height;
+		}
+	}
+	else {
+		if (item->leaf.is_expanded) {
+			// Expanded items have always had their description measured.
+			item->total_height = item_height * (1 + item->leaf.description_line_count + item->leaf.num_values);
+		}
+		else if (!item->is_filtered) {
+			item->total_height = item_height;
+		}
+		else {
+			item->total_height = 0;
+		}
+	}
+
+	return item->total_height;
+}
+
+void debuginator__adjust_num_visible_children(DebuginatorItem* item, int diff) {
+	DEBUGINATOR_assert(item->is_folder);
+	DEBUGINATOR_assert(diff != 0 && item->folder.num_visible_children + diff >= 0);
+	item->folder.num_visible_children += diff;
+	if (item->folder.num_visible_children == 0 && item->parent != NULL) {
+		// Hide us as well
+		debuginator__adjust_num_visible_children(item->parent, -1);
+	}
+	else if (item->folder.num_visible_children == diff && item->parent != NULL) {
+		debuginator__adjust_num_visible_children(item->parent, 1);
+	}
+}
+
+bool debuginator__font_equals(const DebuginatorFont* a, const DebuginatorFont* b) {
+	return a->userdata == b->userdata && a->size == b->size && a->bold == b->bold && a->italic == b->italic;
+}
+
+// Pass NULL as item to invalidate the whole cache.
+void debuginator__invalidate_word_wrap_cache(TheDebuginator* debuginator, DebuginatorItem* item) {
+	for (int i = 0; i < DEBUGINATOR_word_wrap_cache_size; i++) {
+		if (item == NULL || debuginator->word_wrap_cache[i].item == item) {
+			debuginator->word_wrap_cache[i].item = NULL;
+		}
+	}
+}
+
+// The width available to an item's description. Based on the same indentation as when drawing,
+// but without the position of the menu so it doesn't change while it's opening or closing.
+float debuginator__description_width(TheDebuginator* debuginator, DebuginatorItem* item) {
+	float indentation = 10 + 20; // Menu margin + description indentation
+	DebuginatorItem* parent = item->parent;
+	while (parent != NULL && parent != debuginator->root) {
+		indentation += 20;
+		parent = parent->parent;
+	}
+
+	return debuginator->size.x - 50 - indentation;
+}
+
+// Returns the word wrapped description of the item, only calling the word_wrap callback if the
+// description, width or font has changed since last time.
+DebuginatorWordWrapCacheEntry* debuginator__word_wrap_description(TheDebuginator* debuginator, DebuginatorItem* item) {
+	const char* description = item->leaf.description;
+	float width = debuginator__description_width(debuginator, item);
+	DebuginatorFont* font = &debuginator->theme.fonts[DEBUGINATOR_ItemDescription];
+	for (int i = 0; i < DEBUGINATOR_word_wrap_cache_size; i++) {
+		DebuginatorWordWrapCacheEntry* entry = &debuginator->word_wrap_cache[i];
+		if (entry->item == item && entry->description == description && entry->width == width && debuginator__font_equals(&entry->font, font)) {
+			return entry;
+		}
+	}
+
+	DebuginatorWordWrapCacheEntry* entry = &debuginator->word_wrap_cache[debuginator->word_wrap_cache_next];
+	debuginator->word_wrap_cache_next = (debuginator->word_wrap_cache_next + 1) % DEBUGINATOR_word_wrap_cache_size;
+	entry->item = item;
+	entry->description = description;
+	entry->width = width;
+	entry->font = *font;
+	entry->row_count = 0;
+
+	unsigned row_lengths[DEBUGINATOR_max_description_rows];
+	unsigned row_count = 0;
+	debuginator->word_wrap(description, *font, width, &row_count, row_lengths, DEBUGINATOR_max_description_rows, debuginator->app_user_data);
+
+	// Rows that don't fit in the text buffer point to its last char, which is always '\0'.
+	const unsigned text_capacity = sizeof(entry->text) - 1;
+	unsigned text_size = 0;
+	unsigned row_index = 0;
+	for (unsigned i = 0; i < row_count; i++) {
+		unsigned row_length = text_size < text_capacity ? DEBUGINATOR_min(row_lengths[i], text_capacity - text_size - 1) : 0;
+		entry->row_offsets[entry->row_count++] = text_size < text_capacity ? text_size : text_capacity;
+		if (text_size < text_capacity) {
+			DEBUGINATOR_memcpy(entry->text + text_size, description + row_index, row_length);
+			entry->text[text_size + row_length] = '\0';
+			text_size += row_length + 1;
+		}
+
+		row_index += row_lengths[i];
+		while (description[row_index] == '\n') {
+			++row_index;
+		}
+	}
+
+	entry->text[text_capacity] = '\0';
+	return entry;
+}
+
+// The height of a leaf when it's expanded. Descriptions aren't measured when items are created,
+// so this is where it happens the first time an item needs it.
+int debuginator__expanded_height(TheDebuginator* debuginator, DebuginatorItem* item) {
+	item->leaf.description_line_count = (int)debuginator__word_wrap_description(debuginator, item)->row_count;
+	return debuginator->item_height * (1 + item->leaf.description_line_count + item->leaf.num_values);
+}
+
+void debuginator__on_change_theme(DebuginatorItem* item, void* value, const char* value_title, void* app_userdata) {
+	(void)app_userdata;
+	(void)value_title;
+	TheDebuginator* debuginator = (TheDebuginator*)item->user_data;
+	debuginator->theme_index = *(int*)value;
+	debuginator->theme = debuginator->themes[debuginator->theme_index];
+	debuginator__invalidate_word_wrap_cache(debuginator, NULL);
+	debuginator__invalidate_layout(debuginator);
+}
+
+void debuginator_set_title(TheDebuginator* debuginator, DebuginatorItem* item, const char* title, int title_length) {
+	if (title_length == 0) {
+		title_length = (int)DEBUGINATOR_strlen(title);
+	}
+
+	item->title = debuginator_copy_string(debuginator, title, title_length);
+}
+
+DebuginatorItem* debuginator__next_visible_sibling(DebuginatorItem* item) {
+	DebuginatorItem* sibling = item->next_sibling;
 	while (sibling) {
 		if (sibling->is_folder) {
 			if (sibling->folder.num_visible_children > 0) {
 				return sibling;
 			}
 		}
-		else if (sibling->leaf.hot_index != -2 && !sibling->is_filtered) {
+		else if (!sibling->is_filtered) {
 			return sibling;
 		}
 
@@ -858,7 +1917,7 @@ DebuginatorItem* debuginator__prev_visible_sibling(DebuginatorItem* item) {
 				return sibling;
 			}
 		}
-		else if (sibling->leaf.hot_index != -2 && !sibling->is_filtered) {
+		else if (!sibling->is_filtered) {
 			return sibling;
 		}
 
@@ -878,7 +1937,7 @@ DebuginatorItem* debuginator__first_visible_child(DebuginatorItem* item) {
 			return item->folder.first_child;
 		}
 	}
-	else if (item->folder.first_child->leaf.hot_index != -2 && !item->folder.first_child->is_filtered) {
+	else if (!item->folder.first_child->is_filtered) {
 		return item->folder.first_child;
 	}
 
@@ -887,7 +1946,7 @@ DebuginatorItem* debuginator__first_visible_child(DebuginatorItem* item) {
 
 DebuginatorItem* debuginator__find_first_leaf(DebuginatorItem* item) {
 	if (!item->is_folder) {
-		if (item->leaf.hot_index != -2 && !item->is_filtered) {
+		if (!item->is_filtered) {
 			return item;
 		}
 	}
@@ -913,7 +1972,7 @@ DebuginatorItem* debuginator__find_first_leaf(DebuginatorItem* item) {
 
 DebuginatorItem* debuginator__find_last_leaf(DebuginatorItem* item) {
 	if (!item->is_folder) {
-		if (item->leaf.hot_index != -2 && !item->is_filtered) {
+		if (!item->is_filtered) {
 			return item;
 		}
 	}
@@ -1018,16 +2077,27 @@ DebuginatorItem* debuginator_new_folder_item(TheDebuginator* debuginator, Debugi
 	folder_item->folder.num_visible_children = 0;
 	debuginator_set_title(debuginator, folder_item, title, title_length);
 	debuginator_set_parent(folder_item, parent);
-	debuginator__set_total_height(folder_item, debuginator->item_height);
+	debuginator__set_total_height(debuginator, folder_item, debuginator->item_height);
+	debuginator__invalidate_layout(debuginator);
 	return folder_item;
 }
 
-DebuginatorItem* debuginator_get_item(TheDebuginator* debuginator, DebuginatorItem* parent, const char* path, bool create_if_not_exist) {
+// path doesn't need to be null terminated, so it can point into a buffer being loaded.
+DebuginatorItem* debuginator__get_item(TheDebuginator* debuginator, DebuginatorItem* parent, const char* path, int path_length, bool create_if_not_exist) {
 	parent = parent == NULL ? debuginator->root : parent;
+	const char* path_end = path + path_length;
 	const char* temp_path = path;
 	while (true) {
-		const char* next_slash = DEBUGINATOR_strchr(temp_path, '/');
-		size_t path_part_length = next_slash ? next_slash - temp_path : DEBUGINATOR_strlen(temp_path);
+		const char* next_slash = temp_path;
+		while (next_slash < path_end && *next_slash != '/') {
+			++next_slash;
+		}
+
+		if (next_slash == path_end) {
+			next_slash = NULL;
+		}
+
+		size_t path_part_length = next_slash ? next_slash - temp_path : path_end - temp_path;
 
 		DebuginatorItem* current_item = NULL;
 		DebuginatorItem* parent_child = parent->folder.first_child;
@@ -1058,8 +2128,9 @@ DebuginatorItem* debuginator_get_item(TheDebuginator* debuginator, DebuginatorIt
 			// Found the last part of the path
 			if (current_item == NULL) {
 				current_item = (DebuginatorItem*)debuginator__allocate(debuginator, sizeof(DebuginatorItem));
-				debuginator_set_title(debuginator, current_item, temp_path, 0);
+				debuginator_set_title(debuginator, current_item, temp_path, (int)(path_end - temp_path));
 				debuginator_set_parent(current_item, parent);
+				debuginator__invalidate_layout(debuginator);
 			}
 
 			return current_item;
@@ -1081,61 +2152,233 @@ DebuginatorItem* debuginator_get_item(TheDebuginator* debuginator, DebuginatorIt
 	return NULL;
 }
 
-DebuginatorItem* debuginator_create_array_item(TheDebuginator* debuginator,
+DebuginatorItem* debuginator_get_item(TheDebuginator* debuginator, DebuginatorItem* parent, const char* path, bool create_if_not_exist) {
+	return debuginator__get_item(debuginator, parent, path, (int)DEBUGINATOR_strlen(path), create_if_not_exist);
+}
+
+void debuginator__remove_deferred_item(TheDebuginator* debuginator, DebuginatorItem* item) {
+	DebuginatorItem* previous = NULL;
+	DebuginatorItem* deferred = debuginator->first_deferred_item;
+	while (deferred != NULL && deferred != item) {
+		previous = deferred;
+		deferred = deferred->leaf.next_deferred;
+	}
+
+	if (deferred == NULL) {
+		return;
+	}
+
+	if (previous != NULL) {
+		previous->leaf.next_deferred = item->leaf.next_deferred;
+	}
+	else {
+		debuginator->first_deferred_item = item->leaf.next_deferred;
+	}
+
+	if (debuginator->last_deferred_item == item) {
+		debuginator->last_deferred_item = previous;
+	}
+
+	item->leaf.has_deferred_callback = false;
+	item->leaf.next_deferred = NULL;
+}
+
+void debuginator__remove_dirty_item(TheDebuginator* debuginator, DebuginatorItem* item) {
+	DebuginatorItem** link = &debuginator->first_dirty_item;
+	while (*link != NULL && *link != item) {
+		link = &(*link)->leaf.next_dirty;
+	}
+
+	if (*link == item) {
+		*link = item->leaf.next_dirty;
+	}
+
+	item->leaf.is_dirty = false;
+	item->leaf.next_dirty = NULL;
+}
+
+void debuginator__clear_dirty_items(TheDebuginator* debuginator) {
+	DebuginatorItem* item = debuginator->first_dirty_item;
+	while (item != NULL) {
+		DebuginatorItem* next = item->leaf.next_dirty;
+		item->leaf.is_dirty = false;
+		item->leaf.next_dirty = NULL;
+		item = next;
+	}
+
+	debuginator->first_dirty_item = NULL;
+}
+
+void debuginator__remove_overridden_item(TheDebuginator* debuginator, DebuginatorItem* item) {
+	DebuginatorItem** link = &debuginator->first_overridden_item;
+	while (*link != NULL && *link != item) {
+		link = &(*link)->leaf.next_overridden;
+	}
+
+	if (*link == item) {
+		*link = item->leaf.next_overridden;
+	}
+
+	item->leaf.is_overridden = false;
+	item->leaf.next_overridden = NULL;
+}
+
+// Keeps the item on the overridden list exactly when its value differs from the default.
+void debuginator__update_overridden(TheDebuginator* debuginator, DebuginatorItem* item) {
+	bool is_overridden = item->leaf.active_index != item->leaf.default_index;
+	if (is_overridden && !item->leaf.is_overridden) {
+		item->leaf.is_overridden = true;
+		item->leaf.next_overridden = debuginator->first_overridden_item;
+		debuginator->first_overridden_item = item;
+	}
+	else if (!is_overridden && item->leaf.is_overridden) {
+		debuginator__remove_overridden_item(debuginator, item);
+	}
+}
+
+// Sets a value that came from a save. It's already saved so the item doesn't become dirty.
+void debuginator__apply_loaded_value(TheDebuginator* debuginator, DebuginatorItem* item, int index) {
+	item->leaf.hot_index = index;
+	if (debuginator->edit_types[item->leaf.edit_type].forget_state) {
+		return;
+	}
+
+	bool was_dirty = item->leaf.is_dirty;
+	debuginator_activate(debuginator, item, false);
+	if (!was_dirty && item->leaf.is_dirty) {
+		debuginator__remove_dirty_item(debuginator, item);
+	}
+}
+
+DebuginatorItem* debuginator__create_leaf(TheDebuginator* debuginator,
 	DebuginatorItem* parent, const char* path, const char* description,
 	DebuginatorOnItemChangedCallback on_item_changed_callback, void* user_data,
-	const char** value_titles, void* values, int num_values, int value_size) {
+	const char** value_titles, void* values, int num_values, int value_size, DebuginatorRange* range, int default_index) {
 
 	DebuginatorItem* item = debuginator_get_item(debuginator, parent, path, true);
+	if (!item->is_folder) {
+		debuginator__drop_value_title_index(debuginator, item);
+
+		// A queued callback was for the old values, which may no longer exist.
+		if (item->leaf.has_deferred_callback) {
+			debuginator__remove_deferred_item(debuginator, item);
+		}
+		if (item->leaf.range != NULL) {
+			debuginator__deallocate(debuginator, item->leaf.range);
+		}
+		if (item->leaf.edit_type == DEBUGINATOR_EditTypeWatch) {
+			debuginator__deallocate(debuginator, item->leaf.values);
+			item->leaf.edit_type = DEBUGINATOR_EditTypeArray;
+			debuginator->watch_item_count--;
+		}
+	}
+
 	item->is_folder = false;
+	item->leaf.range = range;
 	item->leaf.num_values = num_values;
 	item->leaf.values = values;
 	item->leaf.array_element_size = value_size;
 	item->leaf.value_titles = value_titles;
 	item->leaf.on_item_changed_callback = on_item_changed_callback;
 	item->user_data = user_data;
-	debuginator__set_total_height(item, debuginator->item_height);
+	debuginator__set_total_height(debuginator, item, debuginator->item_height);
 
 	if (item->leaf.hot_index >= num_values) {
 		item->leaf.hot_index = num_values - 1;
 	}
 
+	// Set before any loaded value is applied, so that the loaded value wins. Negative keeps the current indices.
+	if (0 <= default_index && default_index < num_values) {
+		item->leaf.default_index = default_index;
+		item->leaf.hot_index = default_index;
+		item->leaf.active_index = default_index;
+	}
+	debuginator__update_overridden(debuginator, item);
+
 	if (debuginator->hot_item == NULL && !item->is_folder) {
 		item->parent->folder.hot_child = item;
 		debuginator->hot_item = item;
 	}
 
-	// In case the item existed previously from a load.
-	if (item->leaf.description != NULL) {
-		const char* loaded_value_title = item->leaf.description;
-		for (int i = 0; i < item->leaf.num_values; i++) {
-			if (strcmp(item->leaf.value_titles[i], loaded_value_title) == 0) {
-				item->leaf.hot_index = i;
-				debuginator_activate(debuginator, item, false);
-				break;
-			}
+	// In case the item was loaded before it was created.
+	uint32_t loaded_title_hash, loaded_index;
+	if (debuginator->pending_load_count > 0 && debuginator__take_pending_load(debuginator, debuginator__item_path_hash(item), &loaded_title_hash, &loaded_index)) {
+		int index = debuginator__find_value_index(debuginator, item, loaded_title_hash, loaded_index);
+		if (index >= 0) {
+			debuginator__apply_loaded_value(debuginator, item, index);
 		}
 	}
 
 	item->leaf.description = description == NULL ? "" : description;
 	debuginator__adjust_num_visible_children(item->parent, 1);
 
-	if (description && !item->is_folder) {
-		const char* description = item->leaf.description;
-		float description_width = debuginator->size.x - 50;
-		int description_height = 0;
-		unsigned row_lengths[32];
-		unsigned row_count = 0;
-		debuginator->word_wrap(description, debuginator->theme.fonts[DEBUGINATOR_ItemDescription], description_width, &row_count, row_lengths, 32, debuginator->app_user_data);
-		item->leaf.description_line_count = row_count;
-	} else if (!item->is_folder) {
-		item->leaf.description_line_count = 0;
+	// The description is word wrapped when it's first needed, see debuginator__expanded_height.
+	item->leaf.description_line_count = -1;
+	if (item->leaf.is_expanded) {
+		debuginator__set_total_height(debuginator, item, debuginator__expanded_height(debuginator, item));
 	}
 
+	debuginator__invalidate_layout(debuginator);
+
 	//TODO preserve hot item
 	return item;
 }
 
+DebuginatorItem* debuginator_create_array_item(TheDebuginator* debuginator,
+	DebuginatorItem* parent, const char* path, const char* description,
+	DebuginatorOnItemChangedCallback on_item_changed_callback, void* user_data,
+	const char** value_titles, void* values, int num_values, int value_size) {
+	return debuginator__create_leaf(debuginator, parent, path, description, on_item_changed_callback, user_data,
+		value_titles, values, num_values, value_size, NULL, -1);
+}
+
+DebuginatorItem* debuginator_create_watch_item(TheDebuginator* debuginator, const char* path, const char* description,
+	DebuginatorWatchType type, const void* target, const char* format) {
+	DebuginatorItem* item = debuginator__create_leaf(debuginator, NULL, path, description, NULL, NULL, NULL, NULL, 0, 0, NULL, -1);
+	DebuginatorWatch* watch = (DebuginatorWatch*)debuginator__allocate(debuginator, sizeof(DebuginatorWatch));
+	watch->type = type;
+	watch->target = target;
+	watch->generation = debuginator->watch_generation - 1;
+	if (format != NULL) {
+		watch->format = format;
+	}
+	else {
+		watch->format = type == DEBUGINATOR_WatchInt ? "%d" : (type == DEBUGINATOR_WatchFloat ? "%.3f" : "%llu");
+	}
+
+	item->leaf.values = watch;
+	item->leaf.edit_type = DEBUGINATOR_EditTypeWatch;
+	debuginator->watch_item_count++;
+	return item;
+}
+
+DebuginatorItem* debuginator_create_int_range_item(TheDebuginator* debuginator, const char* path, const char* description,
+	DebuginatorOnItemChangedCallback on_item_changed_callback, void* user_data, int min, int max, int step, const char* format) {
+	DEBUGINATOR_assert(step > 0 && max >= min);
+	DebuginatorRange* range = (DebuginatorRange*)debuginator__allocate(debuginator, sizeof(DebuginatorRange));
+	range->is_float = false;
+	range->int_min = min;
+	range->int_step = step;
+	range->format = format != NULL ? format : "%d";
+	return debuginator__create_leaf(debuginator, NULL, path, description, on_item_changed_callback, user_data,
+		NULL, NULL, (max - min) / step + 1, sizeof(int), range, -1);
+}
+
+DebuginatorItem* debuginator_create_float_range_item(TheDebuginator* debuginator, const char* path, const char* description,
+	DebuginatorOnItemChangedCallback on_item_changed_callback, void* user_data, float min, float max, float step, const char* format) {
+	DEBUGINATOR_assert(step > 0 && max >= min);
+	DebuginatorRange* range = (DebuginatorRange*)debuginator__allocate(debuginator, sizeof(DebuginatorRange));
+	range->is_float = true;
+	range->float_min = min;
+	range->float_step = step;
+	range->format = format != NULL ? format : "%.2f";
+
+	// Rounded down, but with some slack so that e.g. 0 to 10 in steps of 0.01 still includes 10.
+	int num_values = (int)((max - min) / step + 1e-4f) + 1;
+	return debuginator__create_leaf(debuginator, NULL, path, description, on_item_changed_callback, user_data,
+		NULL, NULL, num_values, sizeof(float), range, -1);
+}
+
 int debuginator_save(TheDebuginator* debuginator, DebuginatorSaveItemCallback callback, char* save_buffer, int save_buffer_size) {
 	char current_full_path[256] = { 0 };
 	int path_indices[8] = { 0 };
@@ -1163,7 +2406,7 @@ int debuginator_save(TheDebuginator* debuginator, DebuginatorSaveItemCallback ca
 			//int current_path_length = path_indices[current_path_index + 1];
 
 			if (item->leaf.active_index != item->leaf.default_index) {
-				int saved = callback(current_full_path, item->leaf.value_titles[item->leaf.active_index], save_buffer, save_buffer_size);
+				int saved = callback(current_full_path, debuginator__value_title(debuginator, item, item->leaf.active_index), save_buffer, save_buffer_size);
 				if (saved < 0) {
 					return -1;
 				}
@@ -1195,27 +2438,476 @@ int debuginator_save(TheDebuginator* debuginator, DebuginatorSaveItemCallback ca
 	return save_buffer_size;
 }
 
+typedef struct DebuginatorSaveWriter {
+	DebuginatorSaveSinkCallback sink;
+	void* userdata;
+	char chunk[DEBUGINATOR_save_chunk_size];
+	int chunk_size;
+	int total_size;
+	bool aborted;
+} DebuginatorSaveWriter;
+
+void debuginator__save_flush(DebuginatorSaveWriter* writer) {
+	if (writer->chunk_size > 0 && !writer->aborted) {
+		writer->aborted = !writer->sink(writer->chunk, writer->chunk_size, writer->userdata);
+	}
+
+	writer->chunk_size = 0;
+}
+
+void debuginator__save_write(DebuginatorSaveWriter* writer, const char* data, int length) {
+	while (length > 0 && !writer->aborted) {
+		int space = DEBUGINATOR_save_chunk_size - writer->chunk_size;
+		int to_copy = length < space ? length : space;
+		DEBUGINATOR_memcpy(writer->chunk + writer->chunk_size, data, to_copy);
+		writer->chunk_size += to_copy;
+		writer->total_size += to_copy;
+		data += to_copy;
+		length -= to_copy;
+		if (writer->chunk_size == DEBUGINATOR_save_chunk_size) {
+			debuginator__save_flush(writer);
+		}
+	}
+}
+
+// Writes the item's path by walking up to the root first, no temporary path buffer needed.
+void debuginator__save_write_path(DebuginatorSaveWriter* writer, DebuginatorItem* item) {
+	if (item->parent != NULL && item->parent->parent != NULL) {
+		debuginator__save_write_path(writer, item->parent);
+		debuginator__save_write(writer, "/", 1);
+	}
+
+	debuginator__save_write(writer, item->title, (int)DEBUGINATOR_strlen(item->title));
+}
+
+int debuginator_save_stream(TheDebuginator* debuginator, DebuginatorSaveSinkCallback sink, void* userdata) {
+	DebuginatorSaveWriter writer;
+	writer.sink = sink;
+	writer.userdata = userdata;
+	writer.chunk_size = 0;
+	writer.total_size = 0;
+	writer.aborted = false;
+
+	// Only the overridden items are visited, so the cost doesn't depend on how many items there are.
+	for (DebuginatorItem* item = debuginator->first_overridden_item; item != NULL && !writer.aborted; item = item->leaf.next_overridden) {
+		if (item->leaf.active_index == item->leaf.default_index) {
+			continue;
+		}
+
+		const char* value_title = debuginator__value_title(debuginator, item, item->leaf.active_index);
+		debuginator__save_write_path(&writer, item);
+		debuginator__save_write(&writer, "=", 1);
+		debuginator__save_write(&writer, value_title, (int)DEBUGINATOR_strlen(value_title));
+		debuginator__save_write(&writer, "\n", 1);
+	}
+
+	debuginator__save_flush(&writer);
+	if (writer.aborted) {
+		return -1;
+	}
+
+	// A full save contains everything, so it's also the compacted journal.
+	debuginator__clear_dirty_items(debuginator);
+	debuginator->journal_record_count = 0;
+	return writer.total_size;
+}
+
+int debuginator_save_changes(TheDebuginator* debuginator, DebuginatorSaveSinkCallback sink, void* userdata) {
+	DebuginatorSaveWriter writer;
+	writer.sink = sink;
+	writer.userdata = userdata;
+	writer.chunk_size = 0;
+	writer.total_size = 0;
+	writer.aborted = false;
+
+	int num_records = 0;
+	for (DebuginatorItem* item = debuginator->first_dirty_item; item != NULL && !writer.aborted; item = item->leaf.next_dirty) {
+		// Reverting to the default value is written too, so it overrides earlier records when loading.
+		const char* value_title = debuginator__value_title(debuginator, item, item->leaf.active_index);
+		debuginator__save_write_path(&writer, item);
+		debuginator__save_write(&writer, "=", 1);
+		debuginator__save_write(&writer, value_title, (int)DEBUGINATOR_strlen(value_title));
+		debuginator__save_write(&writer, "\n", 1);
+		num_records++;
+	}
+
+	debuginator__save_flush(&writer);
+	if (writer.aborted) {
+		return -1;
+	}
+
+	debuginator__clear_dirty_items(debuginator);
+	debuginator->journal_record_count += num_records;
+	return writer.total_size;
+}
+
+// The binary settings format, all little endian:
+// Header: "DBGB", u32 version, u32 entry count, u32 string table size
+// Entries, sorted by path hash: u64 path hash, u32 value title hash, u32 value index
+// String table, optional: the same "path=value\n" lines as debuginator_save_stream, in menu order.
+#define DEBUGINATOR__BINARY_VERSION 1
+#define DEBUGINATOR__BINARY_HEADER_SIZE 16
+#define DEBUGINATOR__BINARY_ENTRY_SIZE 16
+
+void debuginator__write_u32(unsigned char* out, uint32_t value) {
+	for (int i = 0; i < 4; i++) {
+		out[i] = (unsigned char)(value >> (i * 8));
+	}
+}
+
+void debuginator__write_u64(unsigned char* out, uint64_t value) {
+	debuginator__write_u32(out, (uint32_t)value);
+	debuginator__write_u32(out + 4, (uint32_t)(value >> 32));
+}
+
+uint32_t debuginator__read_u32(const unsigned char* in) {
+	return (uint32_t)in[0] | ((uint32_t)in[1] << 8) | ((uint32_t)in[2] << 16) | ((uint32_t)in[3] << 24);
+}
+
+uint64_t debuginator__read_u64(const unsigned char* in) {
+	return (uint64_t)debuginator__read_u32(in) | ((uint64_t)debuginator__read_u32(in + 4) << 32);
+}
+
+typedef void(*DebuginatorLeafVisitor)(TheDebuginator* debuginator, DebuginatorItem* leaf, uint64_t path_hash, void* userdata);
+
+void debuginator__visit_leaves(TheDebuginator* debuginator, DebuginatorItem* folder, uint64_t path_hash, DebuginatorLeafVisitor visitor, void* userdata) {
+	for (DebuginatorItem* item = folder->folder.first_child; item != NULL; item = item->next_sibling) {
+		uint64_t item_hash = debuginator__child_path_hash(item, path_hash);
+		if (item->is_folder) {
+			debuginator__visit_leaves(debuginator, item, item_hash, visitor, userdata);
+		}
+		else {
+			visitor(debuginator, item, item_hash, userdata);
+		}
+	}
+}
+
+typedef struct DebuginatorBinaryWriter {
+	unsigned char* entries; // NULL while only counting
+	int entry_count;
+	char* strings; // NULL while only counting or when not wanted
+	int string_table_size;
+	bool include_strings;
+	bool all_items; // For snapshots, otherwise only items that differ from their default
+} DebuginatorBinaryWriter;
+
+int debuginator__write_path(DebuginatorItem* item, char* out) {
+	int length = 0;
+	if (item->parent != NULL && item->parent->parent != NULL) {
+		length = debuginator__write_path(item->parent, out);
+		if (out != NULL) {
+			out[length] = '/';
+		}
+		length++;
+	}
+
+	int title_length = (int)DEBUGINATOR_strlen(item->title);
+	if (out != NULL) {
+		DEBUGINATOR_memcpy(out + length, item->title, title_length);
+	}
+
+	return length + title_length;
+}
+
+void debuginator__binary_save_leaf(TheDebuginator* debuginator, DebuginatorItem* leaf, uint64_t path_hash, void* userdata) {
+	DebuginatorBinaryWriter* writer = (DebuginatorBinaryWriter*)userdata;
+	if (leaf->leaf.num_values == 0) {
+		return;
+	}
+
+	// Snapshots skip items without state, like presets, so restoring doesn't trigger them.
+	if (writer->all_items ? debuginator->edit_types[leaf->leaf.edit_type].forget_state : leaf->leaf.active_index == leaf->leaf.default_index) {
+		return;
+	}
+
+	const char* value_title = debuginator__value_title(debuginator, leaf, leaf->leaf.active_index);
+	if (writer->entries != NULL) {
+		unsigned char* entry = writer->entries + writer->entry_count * DEBUGINATOR__BINARY_ENTRY_SIZE;
+		debuginator__write_u64(entry, path_hash);
+		debuginator__write_u32(entry + 8, debuginator__value_title_hash(value_title, (int)DEBUGINATOR_strlen(value_title)));
+		debuginator__write_u32(entry + 12, (uint32_t)leaf->leaf.active_index);
+	}
+
+	writer->entry_count++;
+
+	if (writer->include_strings) {
+		char* line = writer->strings == NULL ? NULL : writer->strings + writer->string_table_size;
+		int length = debuginator__write_path(leaf, line);
+		int value_length = (int)DEBUGINATOR_strlen(value_title);
+		if (line != NULL) {
+			line[length] = '=';
+			DEBUGINATOR_memcpy(line + length + 1, value_title, value_length);
+			line[length + 1 + value_length] = '\n';
+		}
+
+		writer->string_table_size += length + value_length + 2;
+	}
+}
+
+void debuginator__binary_swap_entries(unsigned char* entries, int a, int b) {
+	unsigned char temp[DEBUGINATOR__BINARY_ENTRY_SIZE];
+	DEBUGINATOR_memcpy(temp, entries + a * DEBUGINATOR__BINARY_ENTRY_SIZE, DEBUGINATOR__BINARY_ENTRY_SIZE);
+	DEBUGINATOR_memcpy(entries + a * DEBUGINATOR__BINARY_ENTRY_SIZE, entries + b * DEBUGINATOR__BINARY_ENTRY_SIZE, DEBUGINATOR__BINARY_ENTRY_SIZE);
+	DEBUGINATOR_memcpy(entries + b * DEBUGINATOR__BINARY_ENTRY_SIZE, temp, DEBUGINATOR__BINARY_ENTRY_SIZE);
+}
+
+void debuginator__binary_sift_down(unsigned char* entries, int parent, int end) {
+	while (parent * 2 + 1 < end) {
+		int child = parent * 2 + 1;
+		if (child + 1 < end && debuginator__read_u64(entries + (child + 1) * DEBUGINATOR__BINARY_ENTRY_SIZE) > debuginator__read_u64(entries + child * DEBUGINATOR__BINARY_ENTRY_SIZE)) {
+			child++;
+		}
+
+		if (debuginator__read_u64(entries + child * DEBUGINATOR__BINARY_ENTRY_SIZE) <= debuginator__read_u64(entries + parent * DEBUGINATOR__BINARY_ENTRY_SIZE)) {
+			return;
+		}
+
+		debuginator__binary_swap_entries(entries, parent, child);
+		parent = child;
+	}
+}
+
+// In place heap sort on the path hash, so saving needs no memory besides the output buffer.
+void debuginator__binary_sort_entries(unsigned char* entries, int count) {
+	for (int i = count / 2 - 1; i >= 0; i--) {
+		debuginator__binary_sift_down(entries, i, count);
+	}
+
+	for (int end = count - 1; end > 0; end--) {
+		debuginator__binary_swap_entries(entries, 0, end);
+		debuginator__binary_sift_down(entries, 0, end);
+	}
+}
+
+int debuginator__save_binary(TheDebuginator* debuginator, void* buffer, int buffer_size, bool include_strings, bool all_items) {
+	DebuginatorBinaryWriter writer;
+	DEBUGINATOR_memset(&writer, 0, sizeof(writer));
+	writer.include_strings = include_strings;
+	writer.all_items = all_items;
+	debuginator__visit_leaves(debuginator, debuginator->root, DEBUGINATOR__HASH_SEED, debuginator__binary_save_leaf, &writer);
+
+	int entries_size = writer.entry_count * DEBUGINATOR__BINARY_ENTRY_SIZE;
+	int required_size = DEBUGINATOR__BINARY_HEADER_SIZE + entries_size + writer.string_table_size;
+	if (buffer == NULL || buffer_size < required_size) {
+		return required_size;
+	}
+
+	unsigned char* header = (unsigned char*)buffer;
+	header[0] = 'D';
+	header[1] = 'B';
+	header[2] = 'G';
+	header[3] = 'B';
+	debuginator__write_u32(header + 4, DEBUGINATOR__BINARY_VERSION);
+	debuginator__write_u32(header + 8, (uint32_t)writer.entry_count);
+	debuginator__write_u32(header + 12, (uint32_t)writer.string_table_size);
+
+	writer.entries = header + DEBUGINATOR__BINARY_HEADER_SIZE;
+	writer.strings = include_strings ? (char*)writer.entries + entries_size : NULL;
+	writer.entry_count = 0;
+	writer.string_table_size = 0;
+	debuginator__visit_leaves(debuginator, debuginator->root, DEBUGINATOR__HASH_SEED, debuginator__binary_save_leaf, &writer);
+
+	debuginator__binary_sort_entries(writer.entries, writer.entry_count);
+	return required_size;
+}
+
+int debuginator_save_binary(TheDebuginator* debuginator, void* buffer, int buffer_size, bool include_strings) {
+	return debuginator__save_binary(debuginator, buffer, buffer_size, include_strings, false);
+}
+
+int debuginator_snapshot(TheDebuginator* debuginator, void* buffer, int buffer_size) {
+	return debuginator__save_binary(debuginator, buffer, buffer_size, false, true);
+}
+
+typedef struct DebuginatorBinaryReader {
+	const unsigned char* entries;
+	int entry_count;
+	int num_found;
+	int num_loaded;
+	bool is_restore; // Restoring a snapshot only touches items that differ, and they count as changes
+} DebuginatorBinaryReader;
+
+// Returns the entry for path_hash, or NULL. The entries are sorted so this is a binary search.
+const unsigned char* debuginator__binary_find_entry(const unsigned char* entries, int entry_count, uint64_t path_hash) {
+	int low = 0;
+	int high = entry_count - 1;
+	while (low <= high) {
+		int mid = low + (high - low) / 2;
+		const unsigned char* entry = entries + mid * DEBUGINATOR__BINARY_ENTRY_SIZE;
+		uint64_t entry_hash = debuginator__read_u64(entry);
+		if (entry_hash == path_hash) {
+			return entry;
+		}
+		else if (entry_hash < path_hash) {
+			low = mid + 1;
+		}
+		else {
+			high = mid - 1;
+		}
+	}
+
+	return NULL;
+}
+
+// Drops the pending loads of items that exist, since they've already been applied.
+void debuginator__binary_drop_pending_leaf(TheDebuginator* debuginator, DebuginatorItem* leaf, uint64_t path_hash, void* userdata) {
+	(void)leaf;
+	(void)userdata;
+	uint32_t value_title_hash, value_index;
+	debuginator__take_pending_load(debuginator, path_hash, &value_title_hash, &value_index);
+}
+
+void debuginator__binary_load_leaf(TheDebuginator* debuginator, DebuginatorItem* leaf, uint64_t path_hash, void* userdata) {
+	DebuginatorBinaryReader* reader = (DebuginatorBinaryReader*)userdata;
+	if (leaf->leaf.num_values == 0) {
+		return;
+	}
+
+	const unsigned char* entry = debuginator__binary_find_entry(reader->entries, reader->entry_count, path_hash);
+	if (entry == NULL) {
+		return;
+	}
+
+	reader->num_found++;
+	int index = debuginator__find_value_index(debuginator, leaf, debuginator__read_u32(entry + 8), debuginator__read_u32(entry + 12));
+	if (index < 0) {
+		return;
+	}
+
+	if (reader->is_restore) {
+		if (index == leaf->leaf.active_index) {
+			return;
+		}
+
+		leaf->leaf.hot_index = index;
+		debuginator_activate(debuginator, leaf, false);
+	}
+	else {
+		debuginator__apply_loaded_value(debuginator, leaf, index);
+	}
+
+	reader->num_loaded++;
+}
+
+int debuginator__load_binary(TheDebuginator* debuginator, const void* data, int size, bool is_restore) {
+	const unsigned char* header = (const unsigned char*)data;
+	if (data == NULL || size < DEBUGINATOR__BINARY_HEADER_SIZE) {
+		return -1;
+	}
+
+	if (header[0] != 'D' || header[1] != 'B' || header[2] != 'G' || header[3] != 'B' || debuginator__read_u32(header + 4) != DEBUGINATOR__BINARY_VERSION) {
+		return -1;
+	}
+
+	uint32_t entry_count = debuginator__read_u32(header + 8);
+	if (entry_count > (uint32_t)(size - DEBUGINATOR__BINARY_HEADER_SIZE) / DEBUGINATOR__BINARY_ENTRY_SIZE) {
+		return -1;
+	}
+
+	DebuginatorBinaryReader reader;
+	reader.entries = header + DEBUGINATOR__BINARY_HEADER_SIZE;
+	reader.entry_count = (int)entry_count;
+	reader.num_found = 0;
+	reader.num_loaded = 0;
+	reader.is_restore = is_restore;
+	if (reader.entry_count > 0) {
+		debuginator__visit_leaves(debuginator, debuginator->root, DEBUGINATOR__HASH_SEED, debuginator__binary_load_leaf, &reader);
+	}
+
+	// Items that don't exist yet get their values when they're created. This is rare enough that it's
+	// fine to add all entries and walk the menu again to drop the ones that were found.
+	if (reader.num_found < reader.entry_count && !is_restore) {
+		for (int i = 0; i < reader.entry_count; i++) {
+			const unsigned char* entry = reader.entries + i * DEBUGINATOR__BINARY_ENTRY_SIZE;
+			debuginator__add_pending_load(debuginator, debuginator__read_u64(entry), debuginator__read_u32(entry + 8), debuginator__read_u32(entry + 12));
+		}
+
+		if (reader.num_found > 0) {
+			debuginator__visit_leaves(debuginator, debuginator->root, DEBUGINATOR__HASH_SEED, debuginator__binary_drop_pending_leaf, NULL);
+		}
+	}
+
+	return reader.num_loaded;
+}
+
+int debuginator_load_binary(TheDebuginator* debuginator, const void* data, int size) {
+	return debuginator__load_binary(debuginator, data, size, false);
+}
+
+int debuginator_restore(TheDebuginator* debuginator, const void* snapshot, int size) {
+	// The callbacks are queued while the values are set and called together at the end.
+	bool was_deferred = debuginator->defer_callbacks;
+	debuginator->defer_callbacks = true;
+	int num_restored = debuginator__load_binary(debuginator, snapshot, size, true);
+	debuginator_set_deferred_callbacks(debuginator, was_deferred);
+	return num_restored;
+}
+
+int debuginator_load_from_buffer(TheDebuginator* debuginator, const char* data, int size, int* num_dropped) {
+	int num_entries = 0;
+	int dropped = 0;
+	const char* end = data + size;
+	const char* line = data;
+	while (line < end) {
+		const char* line_end = line;
+		while (line_end < end && *line_end != '\n') {
+			++line_end;
+		}
+
+		const char* next_line = line_end + 1;
+		if (line_end > line && line_end[-1] == '\r') {
+			--line_end;
+		}
+
+		if (line < line_end && *line != '#' && *line != ';') {
+			const char* separator = line;
+			while (separator < line_end && *separator != '=') {
+				++separator;
+			}
+
+			if (separator > line && separator < line_end) {
+				uint32_t value_title_hash = debuginator__value_title_hash(separator + 1, (int)(line_end - separator - 1));
+				DebuginatorItem* item = debuginator__get_item(debuginator, NULL, line, (int)(separator - line), false);
+				if (item == NULL) {
+					// Only the items that don't exist yet take up memory.
+					uint64_t path_hash = debuginator__hash_bytes(DEBUGINATOR__HASH_SEED, line, (int)(separator - line));
+					if (!debuginator__add_pending_load(debuginator, path_hash, value_title_hash, ~0u)) {
+						++dropped;
+					}
+				}
+				else if (!item->is_folder) {
+					int index = debuginator__find_value_index(debuginator, item, value_title_hash, ~0u);
+					if (index >= 0) {
+						debuginator__apply_loaded_value(debuginator, item, index);
+					}
+				}
+
+				++num_entries;
+			}
+		}
+
+		line = next_line;
+	}
+
+	if (num_dropped != NULL) {
+		*num_dropped = dropped;
+	}
+
+	return num_entries;
+}
 
 void debuginator_load_item(TheDebuginator* debuginator, const char* path, const char* value_title) {
 	DebuginatorItem* item = debuginator_get_item(debuginator, NULL, path, false);
 	if (item == NULL) {
-		item = debuginator_create_array_item(debuginator, NULL, path, NULL, NULL, NULL, NULL, NULL, 0, 0);
-		item->leaf.description = value_title; // Temporarily reuse description field
-		item->leaf.hot_index = -2;
-		debuginator__set_total_height(item, 0);
-		debuginator__adjust_num_visible_children(item->parent, -1);
+		uint64_t path_hash = debuginator__hash_bytes(DEBUGINATOR__HASH_SEED, path, (int)DEBUGINATOR_strlen(path));
+		debuginator__add_pending_load(debuginator, path_hash, debuginator__value_title_hash(value_title, (int)DEBUGINATOR_strlen(value_title)), ~0u);
 	}
 	else if (item->is_folder) {
 	}
 	else {
-		for (int i = 0; i < item->leaf.num_values; i++) {
-			if (strcmp(item->leaf.value_titles[i], value_title) == 0) {
-				item->leaf.hot_index = i;
-				if (!debuginator->edit_types[item->leaf.edit_type].forget_state) {
-					debuginator_activate(debuginator, item, false);
-				}
-				break;
-			}
+		int index = debuginator__find_value_by_title(debuginator, item, value_title);
+		if (index >= 0) {
+			debuginator__apply_loaded_value(debuginator, item, index);
 		}
 	}
 }
@@ -1241,16 +2933,16 @@ void debuginator_set_default_value(TheDebuginator* debuginator, const char* path
 	}
 
 	if (value_title != NULL) {
-		for (int i = 0; i < item->leaf.num_values; i++) {
-			if (strcmp(value_title, item->leaf.value_titles[i]) == 0) {
-				value_index = i;
-				break;
-			}
+		int index = debuginator__find_value_by_title(debuginator, item, value_title);
+		if (index >= 0) {
+			value_index = index;
 		}
 	}
 
 	if (0 <= value_index && value_index < item->leaf.num_values) {
 		item->leaf.default_index = value_index;
+		debuginator__update_overridden(debuginator, item);
+		debuginator_request_redraw(debuginator);
 	}
 }
 
@@ -1261,6 +2953,7 @@ void debuginator_set_edit_type(TheDebuginator* debuginator, const char* path, De
 	}
 
 	item->leaf.edit_type = edit_type;
+	debuginator__invalidate_layout(debuginator);
 }
 
 // Note: If you remove the last visible item, you must create a new one under the root.
@@ -1301,7 +2994,7 @@ void debuginator_remove_item(TheDebuginator* debuginator, DebuginatorItem* item)
 		debuginator->hot_item = debuginator_nearest_visible_item(item);
 	}
 
-	debuginator__set_total_height(item->parent, item->parent->total_height - item->total_height);
+	debuginator__set_total_height(debuginator, item->parent, item->parent->total_height - item->total_height);
 
 	if (!item->is_folder && !item->is_filtered) {
 		// If it's a folder we've already adjusted the parent's count when we removed the item's children above.
@@ -1310,12 +3003,32 @@ void debuginator_remove_item(TheDebuginator* debuginator, DebuginatorItem* item)
 
 	debuginator__deallocate(debuginator, item->title);
 	if (!item->is_folder) {
+		debuginator__invalidate_word_wrap_cache(debuginator, item);
+		debuginator__remove_animations(debuginator, item);
+		if (item->leaf.is_dirty) {
+			debuginator__remove_dirty_item(debuginator, item);
+		}
+		if (item->leaf.is_overridden) {
+			debuginator__remove_overridden_item(debuginator, item);
+		}
+		if (item->leaf.has_deferred_callback) {
+			debuginator__remove_deferred_item(debuginator, item);
+		}
+		debuginator__drop_value_title_index(debuginator, item);
+		if (item->leaf.range != NULL) {
+			debuginator__deallocate(debuginator, item->leaf.range);
+		}
+		if (item->leaf.edit_type == DEBUGINATOR_EditTypeWatch) {
+			debuginator__deallocate(debuginator, item->leaf.values);
+			debuginator->watch_item_count--;
+		}
 		debuginator__deallocate(debuginator, item->leaf.description);
 	}
 
 	// TODO deallocate value titles
 
 	debuginator__deallocate(debuginator, item);
+	debuginator__invalidate_layout(debuginator);
 }
 
 void debuginator_remove_item_by_path(TheDebuginator* debuginator, const char* path) {
@@ -1353,6 +3066,29 @@ bool debuginator__distance_to_hot_item(DebuginatorItem* item, DebuginatorItem* h
 	return false;
 }
 
+// Distance from the root to the hot item, cached until the layout or the hot item changes.
+int debuginator__hot_item_distance(TheDebuginator* debuginator) {
+	DebuginatorItem* hot_item = debuginator->hot_item;
+	int hot_index = hot_item != NULL && !hot_item->is_folder ? hot_item->leaf.hot_index : -1;
+	if (debuginator->hot_item_distance_item != hot_item
+		|| debuginator->hot_item_distance_hot_index != hot_index
+		|| debuginator->hot_item_distance_generation != debuginator->layout_generation) {
+		debuginator->hot_item_distance = 0;
+		debuginator__distance_to_hot_item(debuginator->root, hot_item, debuginator->item_height, &debuginator->hot_item_distance);
+		debuginator->hot_item_distance_item = hot_item;
+		debuginator->hot_item_distance_hot_index = hot_index;
+		debuginator->hot_item_distance_generation = debuginator->layout_generation;
+	}
+
+	return debuginator->hot_item_distance;
+}
+
+// The height offset that puts the hot item at focus_height
+float debuginator__wanted_height_offset(TheDebuginator* debuginator) {
+	float wanted_y = debuginator->size.y * debuginator->focus_height;
+	return wanted_y - debuginator__hot_item_distance(debuginator);
+}
+
 int debuginator_total_height(TheDebuginator* debuginator) {
 	int height = 0;
 	DebuginatorItem *last_item = debuginator__first_visible_child(debuginator->root);
@@ -1382,12 +3118,181 @@ bool debuginator_is_filtering_enabled(TheDebuginator* debuginator) {
 	return debuginator->filter_enabled;
 }
 
-void debuginator_set_filtering_enabled(TheDebuginator* debuginator, bool enabled) {
-	debuginator->filter_enabled = enabled;
-}
+void debuginator_set_filtering_enabled(TheDebuginator* debuginator, bool enabled) {
+	debuginator->filter_enabled = enabled;
+}
+
+const char* debuginator_get_filter(TheDebuginator* debuginator) {
+	return debuginator->filter;
+}
+
+// Fuzzy matches the filter against a lower cased "folder folder title" path. Returns true if it doesn't match.
+bool debuginator__score_filter_path(const char* filter, bool exact_search, const char* path, int path_length, int title_start, int* out_score) {
+	bool taken_chars[512] = { 0 };
+	DEBUGINATOR_assert(path_length < sizeof(taken_chars));
+
+	int score = -1;
+	bool is_filtered = false;
+
+	int filter_part = 0;
+	while (filter[filter_part] != '\0') {
+		if (filter[filter_part] == ' ') {
+			++filter_part;
+			continue;
+		}
+
+		int path_part = 0;
+		int matches[8] = { 0 };
+		int match_count = 0;
+		while (path[path_part] != '\0') {
+			bool filter_part_found = false;
+			for (int path_i = path_part; path_i < path_length; path_i++) {
+				if (path[path_i] == filter[filter_part] && taken_chars[path_i] == false) {
+					path_part = path_i;
+					filter_part_found = true;
+					break;
+				}
+			}
+
+			if (!filter_part_found) {
+				break;
+			}
+
+			int match_length = 0;
+			const char* filter_char = filter + filter_part;
+			const char* path_char = path + path_part;
+			while (*filter_char++ == *path_char++) {
+				match_length++;
+				if (*filter_char == '\0' || *filter_char == ' ' || taken_chars[path_part + match_length] == true) {
+					break;
+				}
+			}
+
+			if (exact_search) {
+				if (filter[filter_part + match_length] != '\0' && filter[filter_part + match_length] != ' ') {
+					path_part += 1;
+					continue;
+				}
+			}
+
+			matches[match_count++] = path_part;
+			matches[match_count++] = match_length;
+			path_part += match_length;
+
+			if (match_count == 8) {
+				break;
+			}
+		}
+
+		int best_match_index = -1;
+		int best_match_score = -1;
+		for (int i = 0; i < match_count; i += 2) {
+			int match_index = matches[i];
+			int match_length = matches[i + 1];
+			int is_word_break_start = match_index == 0
+				|| path[match_index - 1] == ' '
+				|| (!DEBUGINATOR_isalpha(path[match_index - 1]) && DEBUGINATOR_isalpha(path[match_index]))
+				|| (!DEBUGINATOR_isdigit(path[match_index - 1]) && DEBUGINATOR_isdigit(path[match_index]));
+			int is_word_break_end = match_index + match_length == path_length
+				|| path[match_index + match_length] == ' '
+				|| (!DEBUGINATOR_isalpha(path[match_index + match_length]) && DEBUGINATOR_isalpha(path[match_index]))
+				|| (!DEBUGINATOR_isdigit(path[match_index + match_length]) && DEBUGINATOR_isdigit(path[match_index]));
+			int is_match_in_item_title = match_index >= title_start;
+			int match_score = (is_word_break_start * 10 + is_word_break_end * 5 + is_match_in_item_title * 10 + match_length) * match_length;
+			if (match_score > best_match_score) {
+				best_match_score = match_score;
+				best_match_index = i;
+			}
+		}
+
+		if (best_match_index == -1) {
+			is_filtered = true;
+			score = -1;
+			break; // Filter not valid
+		}
+		else {
+			filter_part += matches[best_match_index + 1];
+			score += best_match_score;
+			for (int match_i = 0; match_i < matches[best_match_index + 1]; match_i++) {
+				taken_chars[matches[best_match_index] + match_i] = true;
+			}
+		}
+	}
+
+	*out_score = score;
+	return is_filtered;
+}
+
+typedef struct DebuginatorFilterBatch {
+	DebuginatorFilterLeaf* leaves;
+	int leaf_capacity;
+	int leaf_count;
+	char* paths;
+	int paths_capacity;
+	int paths_used;
+	const char* filter;
+	bool exact_search;
+
+	int best_score;
+	DebuginatorItem* best_item;
+} DebuginatorFilterBatch;
+
+// Only touches the leaves' own entries, so any range can run on any thread.
+void debuginator__score_filter_leaves(void* task_data, int begin, int end) {
+	DebuginatorFilterBatch* batch = (DebuginatorFilterBatch*)task_data;
+	for (int leaf_i = begin; leaf_i < end; leaf_i++) {
+		DebuginatorFilterLeaf* leaf = &batch->leaves[leaf_i];
+		char* path = batch->paths + leaf->path_offset;
+		for (int i = leaf->title_start; i < leaf->path_length; i++) {
+			path[i] = (char)DEBUGINATOR_tolower(path[i]);
+		}
+
+		leaf->is_filtered = debuginator__score_filter_path(batch->filter, batch->exact_search, path, leaf->path_length, leaf->title_start, &leaf->score);
+	}
+}
+
+// Scores the batched leaves, then applies the results in tree order so that the visibility
+// changes and the best item are the same as when scoring one leaf at a time.
+void debuginator__flush_filter_batch(TheDebuginator* debuginator, DebuginatorFilterBatch* batch) {
+	if (batch->leaf_count == 0) {
+		return;
+	}
+
+	if (debuginator->parallel_for != NULL) {
+		debuginator->parallel_for(debuginator__score_filter_leaves, batch, batch->leaf_count, debuginator->app_user_data);
+	}
+	else {
+		debuginator__score_filter_leaves(batch, 0, batch->leaf_count);
+	}
+
+	for (int leaf_i = 0; leaf_i < batch->leaf_count; leaf_i++) {
+		DebuginatorFilterLeaf* leaf = &batch->leaves[leaf_i];
+		DebuginatorItem* item = leaf->item;
+		bool is_filtered = leaf->is_filtered;
+		int score = leaf->score;
+		if (is_filtered && !item->is_filtered) {
+			debuginator__set_total_height(debuginator, item, 0);
+			debuginator__adjust_num_visible_children(item->parent, -1);
+			item->leaf.is_expanded = false;
+		}
+		else if (!is_filtered && item->is_filtered) {
+			debuginator__set_total_height(debuginator, item, debuginator->item_height); //Hacky
+			debuginator__adjust_num_visible_children(item->parent, 1);
+		}
+
+		item->is_filtered = is_filtered;
+
+		if (score > batch->best_score) {
+			if (item == debuginator->hot_item) {
+				score++;
+			}
+			batch->best_score = score;
+			batch->best_item = item;
+		}
+	}
 
-const char* debuginator_get_filter(TheDebuginator* debuginator) {
-	return debuginator->filter;
+	batch->leaf_count = 0;
+	batch->paths_used = 0;
 }
 
 void debuginator_update_filter(TheDebuginator* debuginator, const char* wanted_filter) {
@@ -1430,13 +3335,32 @@ void debuginator_update_filter(TheDebuginator* debuginator, const char* wanted_f
 		}
 	//}
 
+	DebuginatorFilterLeaf serial_leaves[32];
+	char serial_paths[32 * DEBUGINATOR_filter_path_budget];
+	DebuginatorFilterBatch batch;
+	batch.filter = filter;
+	batch.exact_search = exact_search;
+	batch.leaf_count = 0;
+	batch.paths_used = 0;
+	batch.best_score = -1;
+	batch.best_item = NULL;
+	if (debuginator->parallel_for != NULL) {
+		batch.leaves = debuginator->filter_batch_leaves;
+		batch.leaf_capacity = debuginator->filter_batch_size;
+		batch.paths = debuginator->filter_batch_paths;
+		batch.paths_capacity = debuginator->filter_batch_size * DEBUGINATOR_filter_path_budget;
+	}
+	else {
+		batch.leaves = serial_leaves;
+		batch.leaf_capacity = sizeof(serial_leaves) / sizeof(serial_leaves[0]);
+		batch.paths = serial_paths;
+		batch.paths_capacity = sizeof(serial_paths);
+	}
+
 	char current_full_path[512] = { 0 };
 	int path_indices[16] = { 0 };
 	int current_path_index = 0;
 
-	int best_score = -1;
-	DebuginatorItem* best_item = NULL;
-
 	DebuginatorItem* item = debuginator->root->folder.first_child;
 	while (item != NULL) {
 		if (item->is_folder) {
@@ -1462,126 +3386,24 @@ void debuginator_update_filter(TheDebuginator* debuginator, const char* wanted_f
 			}
 		}
 		else {
-			bool taken_chars[512] = { 0 };
-			DEBUGINATOR_assert(sizeof(taken_chars) == sizeof(current_full_path)); // Should probably be a static assert but whatevs
-			DEBUGINATOR_strcpy_s(current_full_path + path_indices[current_path_index], 50, item->title);
-			path_indices[current_path_index + 1] = path_indices[current_path_index] + (int)DEBUGINATOR_strlen(item->title);
-			DEBUGINATOR_assert(path_indices[current_path_index + 1] < sizeof(current_full_path));
-			int current_path_length = path_indices[current_path_index + 1];
-
-			//if (!exact_search) {
-				for (size_t i = path_indices[current_path_index]; i < current_path_length; i++) {
-					current_full_path[i] = (char)DEBUGINATOR_tolower(current_full_path[i]);
-				}
-			//}
-
-			int score = -1;
-			bool is_filtered = false;
-
-			int filter_part = 0;
-			while (filter[filter_part] != '\0') {
-				if (filter[filter_part] == ' ') {
-					++filter_part;
-					continue;
-				}
-
-				int path_part = 0;
-				int matches[8] = { 0 };
-				int match_count = 0;
-				while (current_full_path[path_part] != '\0') {
-					bool filter_part_found = false;
-					for (int path_i = path_part; path_i < current_path_length; path_i++) {
-						if (current_full_path[path_i] == filter[filter_part] && taken_chars[path_i] == false) {
-							path_part = path_i;
-							filter_part_found = true;
-							break;
-						}
-					}
-
-					if (!filter_part_found) {
-						break;
-					}
-
-					int match_length = 0;
-					const char* filter_char = filter + filter_part;
-					const char* path_char = current_full_path + path_part;
-					while (*filter_char++ == *path_char++) {
-						match_length++;
-						if (*filter_char == '\0' || *filter_char == ' ' || taken_chars[path_part + match_length] == true) {
-							break;
-						}
-					}
-
-					if (exact_search) {
-						if (filter[filter_part + match_length] != '\0' && filter[filter_part + match_length] != ' ') {
-							path_part += 1;
-							continue;
-						}
-					}
-
-					matches[match_count++] = path_part;
-					matches[match_count++] = match_length;
-					path_part += match_length;
-
-					if (match_count == 8) {
-						break;
-					}
-				}
-
-				int best_match_index = -1;
-				int best_match_score = -1;
-				for (int i = 0; i < match_count; i += 2) {
-					int match_index = matches[i];
-					int match_length = matches[i + 1];
-					int is_word_break_start = match_index == 0
-						|| current_full_path[match_index - 1] == ' '
-						|| (!DEBUGINATOR_isalpha(current_full_path[match_index - 1]) && DEBUGINATOR_isalpha(current_full_path[match_index]))
-						|| (!DEBUGINATOR_isdigit(current_full_path[match_index - 1]) && DEBUGINATOR_isdigit(current_full_path[match_index]));
-					int is_word_break_end = match_index + match_length == current_path_length
-						|| current_full_path[match_index + match_length] == ' '
-						|| (!DEBUGINATOR_isalpha(current_full_path[match_index + match_length]) && DEBUGINATOR_isalpha(current_full_path[match_index]))
-						|| (!DEBUGINATOR_isdigit(current_full_path[match_index + match_length]) && DEBUGINATOR_isdigit(current_full_path[match_index]));
-					int is_match_in_item_title = match_index >= path_indices[current_path_index];
-					int match_score = (is_word_break_start * 10 + is_word_break_end * 5 + is_match_in_item_title * 10 + match_length) * match_length;
-					if (match_score > best_match_score) {
-						best_match_score = match_score;
-						best_match_index = i;
-					}
-				}
-
-				if (best_match_index == -1) {
-					is_filtered = true;
-					score = -1;
-					break; // Filter not valid
-				}
-				else {
-					filter_part += matches[best_match_index + 1];
-					score += best_match_score;
-					for (int match_i = 0; match_i < matches[best_match_index + 1]; match_i++) {
-						taken_chars[matches[best_match_index] + match_i] = true;
-					}
-				}
-			}
-
-			if (is_filtered && !item->is_filtered) {
-				debuginator__set_total_height(item, 0);
-				debuginator__adjust_num_visible_children(item->parent, -1);
-				item->leaf.is_expanded = false;
-			}
-			else if (!is_filtered && item->is_filtered) {
-				debuginator__set_total_height(item, debuginator->item_height); //Hacky
-				debuginator__adjust_num_visible_children(item->parent, 1);
+			int title_start = path_indices[current_path_index];
+			int title_length = (int)DEBUGINATOR_strlen(item->title);
+			int path_length = title_start + title_length;
+			DEBUGINATOR_assert(path_length < sizeof(current_full_path));
+			if (batch.leaf_count == batch.leaf_capacity || batch.paths_used + path_length + 1 > batch.paths_capacity) {
+				debuginator__flush_filter_batch(debuginator, &batch);
 			}
 
-			item->is_filtered = is_filtered;
-
-			if (score > best_score) {
-				if (item == debuginator->hot_item) {
-					score++;
-				}
-				best_score = score;
-				best_item = item;
-			}
+			DebuginatorFilterLeaf* leaf = &batch.leaves[batch.leaf_count++];
+			leaf->item = item;
+			leaf->path_offset = batch.paths_used;
+			leaf->path_length = path_length;
+			leaf->title_start = title_start;
+			char* path = batch.paths + batch.paths_used;
+			DEBUGINATOR_memcpy(path, current_full_path, title_start);
+			DEBUGINATOR_memcpy(path + title_start, item->title, title_length);
+			path[path_length] = '\0';
+			batch.paths_used += path_length + 1;
 		}
 
 		if (item->next_sibling != NULL) {
@@ -1603,6 +3425,9 @@ void debuginator_update_filter(TheDebuginator* debuginator, const char* wanted_f
 		}
 	}
 
+	debuginator__flush_filter_batch(debuginator, &batch);
+	DebuginatorItem* best_item = batch.best_item;
+
 	if (expanding_search && debuginator->hot_item != NULL) {
 		// We're good. Just keep the previously hot item; it can't have disappeared.
 	}
@@ -1622,30 +3447,24 @@ void debuginator_update_filter(TheDebuginator* debuginator, const char* wanted_f
 	}
 
 	debuginator__set_item_total_height_recursively(debuginator->root, debuginator->item_height);
-
-	int distance_from_root_to_hot_item = 0;
-	debuginator__distance_to_hot_item(debuginator->root, debuginator->hot_item, debuginator->item_height, &distance_from_root_to_hot_item);
-	float wanted_y = debuginator->size.y * debuginator->focus_height;
-	float distance_to_wanted_y = wanted_y - distance_from_root_to_hot_item;
-	debuginator->current_height_offset = distance_to_wanted_y;
+	debuginator__invalidate_layout(debuginator);
+	debuginator->current_height_offset = debuginator__wanted_height_offset(debuginator);
 
 	DEBUGINATOR_strcpy_s(debuginator->filter, sizeof(debuginator->filter), filter);
 }
 
 void debuginator_set_item_height(TheDebuginator* debuginator, int item_height) {
 	debuginator->item_height = item_height;
+	debuginator__invalidate_layout(debuginator);
 	debuginator__set_item_total_height_recursively(debuginator->root, item_height);
-
-	int distance_from_root_to_hot_item = 0;
-	debuginator__distance_to_hot_item(debuginator->root, debuginator->hot_item, debuginator->item_height, &distance_from_root_to_hot_item);
-	float wanted_y = debuginator->size.y * debuginator->focus_height;
-	float distance_to_wanted_y = wanted_y - distance_from_root_to_hot_item;
-	debuginator->current_height_offset = distance_to_wanted_y;
+	debuginator->current_height_offset = debuginator__wanted_height_offset(debuginator);
 }
 
 void debuginator_set_size(TheDebuginator* debuginator, int width, int height) {
 	debuginator->size.x = (float)width;
 	debuginator->size.y = (float)height;
+	debuginator__invalidate_word_wrap_cache(debuginator, NULL);
+	debuginator__invalidate_layout(debuginator);
 }
 
 void debuginator_set_screen_resolution(TheDebuginator* debuginator, int width, int height) {
@@ -1664,6 +3483,12 @@ void debuginator_get_default_config(TheDebuginatorConfig* config) {
 	config->open_direction = 1;
 	config->focus_height = 0.3f;
 	config->item_height = 30;
+	config->hot_item_pulse = true;
+	config->watch_refresh_interval = 0.25f;
+	config->animation_capacity = 64;
+	config->command_queue_capacity = 0;
+	config->commands_per_update = 64;
+	config->filter_batch_size = 1024;
 
 	// Initialize default themes
 	DebuginatorTheme* themes = config->themes;
@@ -1748,6 +3573,8 @@ void debuginator_get_default_config(TheDebuginatorConfig* config) {
 	config->edit_types[DEBUGINATOR_EditTypePreset].quick_draw = debuginator__quick_draw_preset;
 	config->edit_types[DEBUGINATOR_EditTypePreset].expanded_draw = debuginator__expanded_draw_preset;
 	config->edit_types[DEBUGINATOR_EditTypePreset].toggle_by_default = true;
+	config->edit_types[DEBUGINATOR_EditTypeWatch].quick_draw = debuginator__quick_draw_watch;
+	config->edit_types[DEBUGINATOR_EditTypeWatch].forget_state = true;
 }
 
 void debuginator_create(TheDebuginatorConfig* config, TheDebuginator* debuginator) {
@@ -1777,6 +3604,40 @@ void debuginator_create(TheDebuginatorConfig* config, TheDebuginator* debuginato
 	debuginator__block_allocator_init(&debuginator->allocators[4], sizeof(DebuginatorItem), &debuginator->allocator_data);
 	debuginator__block_allocator_init(&debuginator->allocators[5], 1000, &debuginator->allocator_data);
 
+	debuginator->animation_capacity = config->animation_capacity;
+	debuginator->animations = (DebuginatorAnimation*)debuginator__allocate_permanent(debuginator, config->animation_capacity * (int)sizeof(DebuginatorAnimation));
+	if (debuginator->animations == NULL) {
+		debuginator->animation_capacity = 0;
+	}
+
+	debuginator->pending_loads = (DebuginatorPendingLoad**)debuginator__allocate_permanent(debuginator, DEBUGINATOR_pending_load_buckets * (int)sizeof(DebuginatorPendingLoad*));
+
+	if (config->command_queue_capacity > 0) {
+		unsigned capacity = 1;
+		while (capacity < (unsigned)config->command_queue_capacity) {
+			capacity *= 2;
+		}
+
+		debuginator->command_queue = (DebuginatorQueuedCommand*)debuginator__allocate_permanent(debuginator, capacity * (int)sizeof(DebuginatorQueuedCommand));
+		if (debuginator->command_queue != NULL) {
+			debuginator->command_queue_capacity = capacity;
+			for (unsigned i = 0; i < capacity; i++) {
+				debuginator->command_queue[i].sequence = i;
+			}
+		}
+	}
+
+	debuginator->commands_per_update = config->commands_per_update;
+
+	if (config->parallel_for != NULL && config->filter_batch_size > 0) {
+		debuginator->filter_batch_leaves = (DebuginatorFilterLeaf*)debuginator__allocate_permanent(debuginator, config->filter_batch_size * (int)sizeof(DebuginatorFilterLeaf));
+		debuginator->filter_batch_paths = (char*)debuginator__allocate_permanent(debuginator, config->filter_batch_size * DEBUGINATOR_filter_path_budget);
+		if (debuginator->filter_batch_leaves != NULL && debuginator->filter_batch_paths != NULL) {
+			debuginator->parallel_for = config->parallel_for;
+			debuginator->filter_batch_size = config->filter_batch_size;
+		}
+	}
+
 	debuginator->draw_rect = config->draw_rect;
 	debuginator->draw_text = config->draw_text;
 	debuginator->word_wrap = config->word_wrap;
@@ -1789,6 +3650,8 @@ void debuginator_create(TheDebuginatorConfig* config, TheDebuginator* debuginato
 	debuginator->focus_height = config->focus_height;
 	debuginator->screen_resolution = config->screen_resolution;
 	debuginator->item_height = config->item_height;
+	debuginator->hot_item_pulse = config->hot_item_pulse;
+	debuginator->watch_refresh_interval = config->watch_refresh_interval;
 
 	debuginator->root_position.x = -debuginator->size.x;
 	debuginator->top_left = debuginator__vector2(debuginator->root_position.x + debuginator->size.x * debuginator->openness * debuginator->open_direction, 0);
@@ -1798,11 +3661,26 @@ void debuginator_create(TheDebuginatorConfig* config, TheDebuginator* debuginato
 	debuginator->theme_index = 0;
 	debuginator->theme = debuginator->themes[0];
 
+	debuginator->bool_values[0] = false;
+	debuginator->bool_values[1] = true;
+	debuginator->bool_titles[0] = "False";
+	debuginator->bool_titles[1] = "True";
+	debuginator->direction_values[0] = 1;
+	debuginator->direction_values[1] = -1;
+	debuginator->direction_titles[0] = "Left";
+	debuginator->direction_titles[1] = "Right";
+	for (int i = 0; i < 4; i++) {
+		debuginator->theme_values[i] = i;
+	}
+	debuginator->theme_titles[0] = "Classic";
+	debuginator->theme_titles[1] = "Blue";
+	debuginator->theme_titles[2] = "High Contrast Dark";
+	debuginator->theme_titles[3] = "High Contrast Light";
+
 	// Create root
 	DebuginatorItem* item = debuginator_new_folder_item(debuginator, NULL, "Menu Root", 0);
 	debuginator->root = item;
 
-	// TODO: Don't use static variables
 	if (config->create_default_debuginator_items) {
 		{
 			debuginator_create_array_item(debuginator, NULL, "Debuginator/Help/About",
@@ -1826,23 +3704,189 @@ void debuginator_create(TheDebuginatorConfig* config, TheDebuginator* debuginato
 		}
 		{
 			// TODO: Use a special callback instead of copy 1 byte in order to fix startup wonky animations.
-			static char directions[2] = { 1, -1 };
-			static const char* string_titles[2] = { "Left", "Right" };
 			debuginator_create_array_item(debuginator, NULL, "Debuginator/Alignment",
 				"Right alignment is not fully tested and has some visual glitches.", debuginator_copy_1byte, &debuginator->open_direction,
-				string_titles, directions, 2, sizeof(directions[0]));
+				debuginator->direction_titles, debuginator->direction_values, 2, sizeof(debuginator->direction_values[0]));
 		}
 		{
-			static int theme_indices[4] = { 0, 1, 2, 3 };
-			static const char* string_titles[4] = { "Classic", "Blue", "High Contrast Dark", "High Contrast Light" };
 			debuginator_create_array_item(debuginator, NULL, "Debuginator/Theme",
 				"Change color theme of The Debuginator. \nNote that only Classic is currently polished.", debuginator__on_change_theme, debuginator,
-				string_titles, (void*)theme_indices, 4, sizeof(theme_indices[0]));
+				debuginator->theme_titles, debuginator->theme_values, 4, sizeof(debuginator->theme_values[0]));
+		}
+	}
+}
+
+// The queue is a bounded MPMC queue as described by Dmitry Vyukov, with a single consumer.
+// Each slot's sequence tells whose turn it is: equal to the position when it's free for the producer
+// claiming that position, one more when it's been filled and is ready for the consumer.
+DebuginatorQueuedCommand* debuginator__queue_claim(TheDebuginator* debuginator) {
+	if (debuginator->command_queue_capacity == 0) {
+		return NULL;
+	}
+
+	unsigned mask = debuginator->command_queue_capacity - 1;
+	for (;;) {
+		unsigned pos = DEBUGINATOR_atomic_load(&debuginator->command_queue_enqueue_pos);
+		DebuginatorQueuedCommand* command = &debuginator->command_queue[pos & mask];
+		int diff = (int)(DEBUGINATOR_atomic_load(&command->sequence) - pos);
+		if (diff == 0) {
+			if (DEBUGINATOR_atomic_cas(&debuginator->command_queue_enqueue_pos, pos, pos + 1)) {
+				return command;
+			}
+		}
+		else if (diff < 0) {
+			// Full, the consumer hasn't gotten to this slot yet.
+			return NULL;
+		}
+
+		// Another producer claimed pos first, try again.
+	}
+}
+
+bool debuginator__queue_push(TheDebuginator* debuginator, DebuginatorQueuedCommandType type, const char* path, const char* text, const DebuginatorQueuedItemData* item_data) {
+	int path_length = (int)DEBUGINATOR_strlen(path);
+	int text_length = text == NULL ? 0 : (int)DEBUGINATOR_strlen(text);
+	if (path_length + text_length + 2 > DEBUGINATOR_queued_strings_size) {
+		return false;
+	}
+
+	DebuginatorQueuedCommand* command = debuginator__queue_claim(debuginator);
+	if (command == NULL) {
+		return false;
+	}
+
+	command->type = type;
+	if (item_data != NULL) {
+		command->item_data = *item_data;
+	}
+
+	command->text_offset = text == NULL ? -1 : path_length + 1;
+	DEBUGINATOR_memcpy(command->strings, path, path_length + 1);
+	if (text != NULL) {
+		DEBUGINATOR_memcpy(command->strings + path_length + 1, text, text_length + 1);
+	}
+
+	// We own the slot, so its sequence can't change under us. Publish it to the consumer.
+	DEBUGINATOR_atomic_store(&command->sequence, command->sequence + 1);
+	return true;
+}
+
+bool debuginator_queue_create_item(TheDebuginator* debuginator, const char* path, const char* description,
+	DebuginatorOnItemChangedCallback on_item_changed_callback, void* user_data,
+	const char** value_titles, void* values, int num_values, int value_size) {
+	DebuginatorQueuedItemData item_data;
+	item_data.on_item_changed_callback = on_item_changed_callback;
+	item_data.user_data = user_data;
+	item_data.value_titles = value_titles;
+	item_data.values = values;
+	item_data.num_values = num_values;
+	item_data.value_size = value_size;
+	return debuginator__queue_push(debuginator, DEBUGINATOR_QueuedCreateItem, path, description, &item_data);
+}
+
+bool debuginator_queue_remove_item(TheDebuginator* debuginator, const char* path) {
+	return debuginator__queue_push(debuginator, DEBUGINATOR_QueuedRemoveItem, path, NULL, NULL);
+}
+
+bool debuginator_queue_set_value(TheDebuginator* debuginator, const char* path, const char* value_title) {
+	return debuginator__queue_push(debuginator, DEBUGINATOR_QueuedSetValue, path, value_title, NULL);
+}
+
+bool debuginator_queue_set_description(TheDebuginator* debuginator, const char* path, const char* description) {
+	return debuginator__queue_push(debuginator, DEBUGINATOR_QueuedSetDescription, path, description, NULL);
+}
+
+void debuginator__set_description(TheDebuginator* debuginator, DebuginatorItem* item, const char* description) {
+	debuginator__invalidate_word_wrap_cache(debuginator, item);
+	debuginator__deallocate(debuginator, item->leaf.description);
+	item->leaf.description = description;
+	item->leaf.description_line_count = -1;
+	if (item->leaf.is_expanded) {
+		debuginator__set_total_height(debuginator, item, debuginator__expanded_height(debuginator, item));
+	}
+
+	debuginator__invalidate_layout(debuginator);
+}
+
+void debuginator__run_queued_command(TheDebuginator* debuginator, DebuginatorQueuedCommand* command) {
+	const char* path = command->strings;
+	const char* text = command->text_offset < 0 ? NULL : command->strings + command->text_offset;
+
+	// The queued strings are gone after this, so the description needs a copy that the debuginator owns.
+	if (command->type == DEBUGINATOR_QueuedCreateItem) {
+		DebuginatorItem* existing_item = debuginator_get_item(debuginator, NULL, path, false);
+		const char* old_description = existing_item != NULL && !existing_item->is_folder ? existing_item->leaf.description : NULL;
+		const char* description = text == NULL ? NULL : debuginator_copy_string(debuginator, text, 0);
+		DebuginatorQueuedItemData* data = &command->item_data;
+		debuginator_create_array_item(debuginator, NULL, path, description,
+			data->on_item_changed_callback, data->user_data,
+			data->value_titles, data->values, data->num_values, data->value_size);
+
+		// Recreating an item from the queue would otherwise leak the previous copy.
+		debuginator__deallocate(debuginator, old_description);
+		return;
+	}
+
+	DebuginatorItem* item = debuginator_get_item(debuginator, NULL, path, false);
+	if (item == NULL) {
+		return;
+	}
+
+	if (command->type == DEBUGINATOR_QueuedRemoveItem) {
+		debuginator_remove_item(debuginator, item);
+	}
+	else if (item->is_folder) {
+		return;
+	}
+	else if (command->type == DEBUGINATOR_QueuedSetValue) {
+		int index = debuginator__find_value_by_title(debuginator, item, text);
+		if (index >= 0) {
+			item->leaf.hot_index = index;
+			debuginator_activate(debuginator, item, false);
+		}
+	}
+	else if (command->type == DEBUGINATOR_QueuedSetDescription) {
+		debuginator__set_description(debuginator, item, debuginator_copy_string(debuginator, text, 0));
+	}
+}
+
+// Runs up to max_commands queued commands. Returns true if there are more left.
+bool debuginator__run_queued_commands(TheDebuginator* debuginator, int max_commands) {
+	if (debuginator->command_queue_capacity == 0) {
+		return false;
+	}
+
+	unsigned mask = debuginator->command_queue_capacity - 1;
+	for (int i = 0; i < max_commands; i++) {
+		unsigned pos = debuginator->command_queue_dequeue_pos;
+		DebuginatorQueuedCommand* slot = &debuginator->command_queue[pos & mask];
+		if (DEBUGINATOR_atomic_load(&slot->sequence) != pos + 1) {
+			return false;
 		}
+
+		// Copied out so producers can reuse the slot while the command runs.
+		DebuginatorQueuedCommand command = *slot;
+		DEBUGINATOR_atomic_store(&slot->sequence, pos + debuginator->command_queue_capacity);
+		debuginator->command_queue_dequeue_pos = pos + 1;
+		debuginator__run_queued_command(debuginator, &command);
 	}
+
+	unsigned pos = debuginator->command_queue_dequeue_pos;
+	return DEBUGINATOR_atomic_load(&debuginator->command_queue[pos & mask].sequence) == pos + 1;
 }
 
-void debuginator_update(TheDebuginator* debuginator, float dt) {
+// Returns true if it needs to be called again next frame. If it returns false, it can be
+// skipped until the menu is opened or changed through the API. While closed it only runs queued commands,
+// so keep calling it if other threads queue commands. While open with watch items it always returns true,
+// since it's what refreshes them.
+bool debuginator_update(TheDebuginator* debuginator, float dt) {
+	bool has_queued_commands = debuginator__run_queued_commands(debuginator, debuginator->commands_per_update);
+
+	// Nothing can change while fully closed, debuginator_set_open takes care of the rest.
+	if (!debuginator->is_open && debuginator->openness == 0) {
+		return has_queued_commands;
+	}
+
 	// To not lerp outside 1
 	if (dt > 0.5f) {
 		dt = 0.5f;
@@ -1850,6 +3894,16 @@ void debuginator_update(TheDebuginator* debuginator, float dt) {
 
 	debuginator->dt = dt;
 	debuginator->draw_timer += dt * 5;
+
+	// The new generation changes the frame signature, so the watches get redrawn at the refresh rate.
+	if (debuginator->watch_item_count > 0) {
+		debuginator->watch_timer += dt;
+		if (debuginator->watch_timer >= debuginator->watch_refresh_interval) {
+			debuginator->watch_timer = 0;
+			debuginator->watch_generation++;
+		}
+	}
+
 	if (debuginator->is_open && debuginator->openness < 1) {
 		debuginator->openness_timer += dt * 5;
 		if (debuginator->openness_timer > 1) {
@@ -1875,10 +3929,7 @@ void debuginator_update(TheDebuginator* debuginator, float dt) {
 	}
 
 	// Ensure hot item is smoothly placed at a nice position
-	int distance_from_root_to_hot_item = 0;
-	debuginator__distance_to_hot_item(debuginator->root, debuginator->hot_item, debuginator->item_height, &distance_from_root_to_hot_item);
-	float wanted_y = debuginator->size.y * debuginator->focus_height;
-	float distance_to_wanted_y = wanted_y - distance_from_root_to_hot_item;
+	float distance_to_wanted_y = debuginator__wanted_height_offset(debuginator);
 	debuginator->current_height_offset = debuginator__lerp(debuginator->current_height_offset, distance_to_wanted_y, DEBUGINATOR_min(1, dt * 10));
 	if (DEBUGINATOR_fabs(debuginator->current_height_offset - distance_to_wanted_y) < 0.1f) {
 		debuginator->current_height_offset = distance_to_wanted_y;
@@ -1894,15 +3945,105 @@ void debuginator_update(TheDebuginator* debuginator, float dt) {
 
 	// Update "origin" position
 	debuginator->top_left = debuginator__vector2(debuginator->root_position.x + debuginator->size.x * debuginator->openness * debuginator->open_direction, 0);
+
+	bool is_opening_or_closing = debuginator->is_open ? debuginator->openness < 1 : debuginator->openness > 0;
+	bool is_scrolling = debuginator->current_height_offset != distance_to_wanted_y;
+	bool is_pulsing = debuginator->is_open && debuginator->hot_item_pulse;
+	return is_opening_or_closing || is_scrolling || is_pulsing || debuginator->animation_count > 0 || debuginator->drawn_frame_animating || has_queued_commands || (debuginator->is_open && debuginator->watch_item_count > 0);
 }
 
 
 float debuginator_draw_item(TheDebuginator* debuginator, DebuginatorItem* item, DebuginatorVector2 offset, bool hot);
 
-void debuginator_draw(TheDebuginator* debuginator, float dt) {
+DebuginatorColor debuginator__hot_item_title_color(TheDebuginator* debuginator) {
+	DebuginatorColor color = debuginator->theme.colors[DEBUGINATOR_ItemTitleActive1];
+	if (!debuginator->hot_item_pulse) {
+		return color;
+	}
+
+	float lerp_t = (float)(DEBUGINATOR_sin(debuginator->draw_timer * 2) + 1) * 0.5f;
+	color.r = (unsigned char)debuginator__lerp((float)debuginator->theme.colors[DEBUGINATOR_ItemTitleActive1].r, (float)debuginator->theme.colors[DEBUGINATOR_ItemTitleActive2].r, lerp_t);
+	color.g = (unsigned char)debuginator__lerp((float)debuginator->theme.colors[DEBUGINATOR_ItemTitleActive1].g, (float)debuginator->theme.colors[DEBUGINATOR_ItemTitleActive2].g, lerp_t);
+	color.b = (unsigned char)debuginator__lerp((float)debuginator->theme.colors[DEBUGINATOR_ItemTitleActive1].b, (float)debuginator->theme.colors[DEBUGINATOR_ItemTitleActive2].b, lerp_t);
+	return color;
+}
+
+// Hashes everything that affects what debuginator_draw outputs, except for things that are
+// animated inside draw itself - those set drawn_frame_animating instead.
+uint64_t debuginator__frame_signature(TheDebuginator* debuginator) {
+	uint64_t hash = DEBUGINATOR__HASH_SEED;
+	hash = debuginator__hash_bytes(hash, &debuginator->is_open, sizeof(debuginator->is_open));
+	hash = debuginator__hash_bytes(hash, &debuginator->openness, sizeof(debuginator->openness));
+	if (!debuginator->is_open && debuginator->openness == 0) {
+		return hash;
+	}
+
+	hash = debuginator__hash_bytes(hash, &debuginator->hot_item, sizeof(debuginator->hot_item));
+	if (debuginator->hot_item != NULL && !debuginator->hot_item->is_folder) {
+		hash = debuginator__hash_bytes(hash, &debuginator->hot_item->leaf.hot_index, sizeof(debuginator->hot_item->leaf.hot_index));
+		hash = debuginator__hash_bytes(hash, &debuginator->hot_item->leaf.is_expanded, sizeof(debuginator->hot_item->leaf.is_expanded));
+	}
+
+	hash = debuginator__hash_bytes(hash, &debuginator->top_left, sizeof(debuginator->top_left));
+	hash = debuginator__hash_bytes(hash, &debuginator->current_height_offset, sizeof(debuginator->current_height_offset));
+	hash = debuginator__hash_bytes(hash, &debuginator->size, sizeof(debuginator->size));
+	hash = debuginator__hash_bytes(hash, &debuginator->theme_index, sizeof(debuginator->theme_index));
+	hash = debuginator__hash_bytes(hash, &debuginator->layout_generation, sizeof(debuginator->layout_generation));
+	hash = debuginator__hash_bytes(hash, &debuginator->redraw_generation, sizeof(debuginator->redraw_generation));
+	hash = debuginator__hash_bytes(hash, debuginator->filter, DEBUGINATOR_strlen(debuginator->filter));
+	hash = debuginator__hash_bytes(hash, &debuginator->filter_enabled, sizeof(debuginator->filter_enabled));
+	hash = debuginator__hash_bytes(hash, &debuginator->filter_timer, sizeof(debuginator->filter_timer));
+	hash = debuginator__hash_bytes(hash, &debuginator->watch_generation, sizeof(debuginator->watch_generation));
+
+	DebuginatorColor pulse_color = debuginator__hot_item_title_color(debuginator);
+	hash = debuginator__hash_bytes(hash, &pulse_color, sizeof(pulse_color));
+
+	bool caret_bright = debuginator->filter_enabled && debuginator->filter_timer * DEBUGINATOR_sin(debuginator->draw_timer) < 0.5;
+	hash = debuginator__hash_bytes(hash, &caret_bright, sizeof(caret_bright));
+	return hash;
+}
+
+bool debuginator_needs_redraw(TheDebuginator* debuginator) {
+	return debuginator->drawn_frame_animating || debuginator->drawn_frame_signature != debuginator__frame_signature(debuginator);
+}
+
+void debuginator_request_redraw(TheDebuginator* debuginator) {
+	debuginator->redraw_generation++;
+}
+
+bool debuginator__draw(TheDebuginator* debuginator, float dt);
+
+bool debuginator_draw(TheDebuginator* debuginator, float dt) {
+	DebuginatorDrawSnapshots* snapshots = debuginator->draw_snapshots;
+	if (snapshots == NULL) {
+		return debuginator__draw(debuginator, dt);
+	}
+
+	// An unchanged frame isn't published, the render thread already has it.
+	debuginator->command_buffer = &snapshots->buffers[snapshots->write_index];
+	bool changed = debuginator__draw(debuginator, dt);
+	if (changed) {
+		debuginator__publish_draw_snapshot(snapshots);
+	}
+
+	return changed;
+}
+
+bool debuginator__draw(TheDebuginator* debuginator, float dt) {
+	if (debuginator->command_buffer != NULL) {
+		debuginator->command_buffer->command_count = 0;
+		debuginator->command_buffer->string_pool_size = 0;
+		debuginator->command_buffer->overflowed = false;
+	}
+
+	uint64_t signature = debuginator__frame_signature(debuginator);
+	bool changed = debuginator->drawn_frame_animating || debuginator->drawn_frame_signature != signature;
+	debuginator->drawn_frame_signature = signature;
+	debuginator->drawn_frame_animating = false;
+
 	// Don't do anything if we're fully closed
 	if (!debuginator->is_open && debuginator->openness == 0) {
-		return;
+		return changed;
 	}
 
 	// Update theme opacity
@@ -1911,35 +4052,36 @@ void debuginator_draw(TheDebuginator* debuginator, float dt) {
 		debuginator->theme.colors[i].a = (unsigned char)(source_theme->colors[i].a * debuginator->openness);
 	}
 
-	float lerp_t = (float)(DEBUGINATOR_sin(debuginator->draw_timer * 2) + 1) * 0.5f;
-	debuginator->theme.colors[DEBUGINATOR_ItemTitleActive].r = (unsigned char)debuginator__lerp((float)debuginator->theme.colors[DEBUGINATOR_ItemTitleActive1].r, (float)debuginator->theme.colors[DEBUGINATOR_ItemTitleActive2].r, lerp_t);
-	debuginator->theme.colors[DEBUGINATOR_ItemTitleActive].g = (unsigned char)debuginator__lerp((float)debuginator->theme.colors[DEBUGINATOR_ItemTitleActive1].g, (float)debuginator->theme.colors[DEBUGINATOR_ItemTitleActive2].g, lerp_t);
-	debuginator->theme.colors[DEBUGINATOR_ItemTitleActive].b = (unsigned char)debuginator__lerp((float)debuginator->theme.colors[DEBUGINATOR_ItemTitleActive1].b, (float)debuginator->theme.colors[DEBUGINATOR_ItemTitleActive2].b, lerp_t);
+	DebuginatorColor hot_item_title_color = debuginator__hot_item_title_color(debuginator);
+	debuginator->theme.colors[DEBUGINATOR_ItemTitleActive].r = hot_item_title_color.r;
+	debuginator->theme.colors[DEBUGINATOR_ItemTitleActive].g = hot_item_title_color.g;
+	debuginator->theme.colors[DEBUGINATOR_ItemTitleActive].b = hot_item_title_color.b;
 
 	// Background
 	DebuginatorVector2 offset = debuginator->top_left;
-	debuginator->draw_rect(&offset, &debuginator->size, &debuginator->theme.colors[DEBUGINATOR_Background], debuginator->app_user_data);
+	debuginator_draw_rect(debuginator, &offset, &debuginator->size, &debuginator->theme.colors[DEBUGINATOR_Background]);
 
 	offset.y = debuginator->current_height_offset;
 
 	// Draw all items
 	offset.x += 10;
 	DebuginatorItem* item_to_draw = debuginator__first_visible_child(debuginator->root);
-	while (item_to_draw && offset.y < -item_to_draw->total_height) {
+	while (item_to_draw && offset.y < 0) {
 		// We'll start to draw off-screen which we don't want.
-		if (offset.y + item_to_draw->total_height < 0) {
+		if (offset.y + item_to_draw->total_height <= 0) {
 			// Whole item is off-screen, skip to sibling
 			offset.y += item_to_draw->total_height;
 			item_to_draw = debuginator__next_visible_sibling(item_to_draw);
 		}
-		else if (item_to_draw->is_folder) {
-			// Part of item is off-screen, find which child to draw
+		else if (item_to_draw->is_folder && offset.y + debuginator->item_height <= 0 && debuginator__first_visible_child(item_to_draw) != NULL) {
+			// Folder title is off-screen, find which child to draw
 			offset.x += 20;
 			offset.y += debuginator->item_height;
 			item_to_draw = debuginator__first_visible_child(item_to_draw);
 		}
 		else {
-			DEBUGINATOR_assert(false);
+			// Partly visible, draw it from here
+			break;
 		}
 	}
 
@@ -1958,22 +4100,25 @@ void debuginator_draw(TheDebuginator* debuginator, float dt) {
 		item_to_draw = debuginator__next_visible_sibling(item_to_draw);
 	}
 
-	// Update animations
-	int running_animations = debuginator->animation_count; // Can be cleverer I guess
-	for (int i = 0; i < debuginator->animation_count; i++) {
+	// Update animations, finished ones are swap removed
+	for (int i = 0; i < debuginator->animation_count;) {
 		DebuginatorAnimation* animation = &debuginator->animations[i];
-		if (animation->time == animation->duration) {
-			--running_animations;
+		animation->time += dt;
+		if (animation->time >= animation->duration) {
+			*animation = debuginator->animations[--debuginator->animation_count];
 			continue;
 		}
 
-		animation->time += dt;
-		if (animation->time > animation->duration) {
-			animation->time = animation->duration;
-		}
 		if (animation->type == DEBUGINATOR_ItemActivate) {
-			int distance_from_root_to_item = 0;
-			debuginator__distance_to_hot_item(debuginator->root, animation->data.item_activate.item, debuginator->item_height, &distance_from_root_to_item);
+			DebuginatorItem* item = animation->data.item_activate.item;
+			if (animation->target_generation != debuginator->layout_generation || animation->target_hot_index != item->leaf.hot_index) {
+				animation->target_distance = 0;
+				debuginator__distance_to_hot_item(debuginator->root, item, debuginator->item_height, &animation->target_distance);
+				animation->target_hot_index = item->leaf.hot_index;
+				animation->target_generation = debuginator->layout_generation;
+			}
+
+			int distance_from_root_to_item = animation->target_distance;
 
 			DebuginatorVector2 start_position = animation->data.item_activate.start_pos;
 			DebuginatorVector2 end_position;
@@ -1988,17 +4133,20 @@ void debuginator_draw(TheDebuginator* debuginator, float dt) {
 			position.x = debuginator__ease_out(animation->time, start_position.x, end_position.x - start_position.x, animation->duration);
 			position.y = debuginator__ease_out(animation->time, start_position.y, end_position.y - start_position.y, animation->duration);
 			DebuginatorFont* font = &debuginator->theme.fonts[DEBUGINATOR_ItemTitle];
-			const char* text = animation->data.item_activate.item->leaf.value_titles[animation->data.item_activate.value_index];
-			debuginator->draw_text(text, &position, &debuginator->theme.colors[DEBUGINATOR_ItemTitleActive], font, debuginator->app_user_data);
-
+			const char* text = debuginator__value_title(debuginator, animation->data.item_activate.item, animation->data.item_activate.value_index);
+			debuginator_draw_text(debuginator, text, &position, &debuginator->theme.colors[DEBUGINATOR_ItemTitleActive], font);
 		}
+
+		++i;
 	}
 
-	if (running_animations == 0) {
-		debuginator->animation_count = 0;
+	if (debuginator->animation_count > 0) {
+		debuginator->drawn_frame_animating = true;
 	}
 	offset.x -= 10;
 
+	float filter_timer_before = debuginator->filter_timer;
+
 	// Draw search filter
 	bool filter_hint_mode = !debuginator->filter_enabled && debuginator->current_height_offset > 100;
 	if (debuginator->filter_enabled || filter_hint_mode) {
@@ -2022,18 +4170,18 @@ void debuginator_draw(TheDebuginator* debuginator, float dt) {
 		DebuginatorVector2 filter_pos = debuginator__vector2(debuginator->top_left.x + debuginator->size.x - 450, 25);
 		DebuginatorVector2 filter_size = debuginator__vector2(150 + (debuginator->size.x - 250) * debuginator->filter_timer, 50);
 		DebuginatorColor filter_color = debuginator__color(50, 100, 50, (int)(200 * debuginator->filter_timer * alpha));
-		debuginator->draw_rect(&filter_pos, &filter_size, &filter_color, debuginator->app_user_data);
+		debuginator_draw_rect(debuginator, &filter_pos, &filter_size, &filter_color);
 
 		DebuginatorVector2 header_text_size = debuginator->text_size("Search: ", &debuginator->theme.fonts[DEBUGINATOR_ItemTitleActive], debuginator->app_user_data);
 		filter_size.x = header_text_size.x + 40;
-		debuginator->draw_rect(&filter_pos, &filter_size, &filter_color, debuginator->app_user_data);
+		debuginator_draw_rect(debuginator, &filter_pos, &filter_size, &filter_color);
 
 		filter_pos.x += 20;
 		filter_pos.y = filter_pos.y + filter_size.y / 2 - header_text_size.y / 2;
 
 		DebuginatorColor header_color = debuginator->theme.colors[DEBUGINATOR_ItemTitleActive];
 		header_color.a = (unsigned char)(header_color.a * alpha);
-		debuginator->draw_text("Search: ", &filter_pos, &header_color, &debuginator->theme.fonts[DEBUGINATOR_ItemTitleActive], debuginator->app_user_data);
+		debuginator_draw_text(debuginator, "Search: ", &filter_pos, &header_color, &debuginator->theme.fonts[DEBUGINATOR_ItemTitleActive]);
 
 		filter_pos.x += 40;
 		filter_pos.x += header_text_size.x;
@@ -2044,18 +4192,18 @@ void debuginator_draw(TheDebuginator* debuginator, float dt) {
 			char letter[2] = { 0 };
 			for (int i = 0; i < DEBUGINATOR_strlen(debuginator->filter); i++) {
 				letter[0] = debuginator->filter[i];
-				debuginator->draw_text(letter, &filter_pos, &debuginator->theme.colors[DEBUGINATOR_ItemTitleActive], &debuginator->theme.fonts[DEBUGINATOR_ItemTitleActive], debuginator->app_user_data);
+				debuginator_draw_text(debuginator, letter, &filter_pos, &debuginator->theme.colors[DEBUGINATOR_ItemTitleActive], &debuginator->theme.fonts[DEBUGINATOR_ItemTitleActive]);
 				DebuginatorVector2 letter_text_size = debuginator->text_size(letter, &debuginator->theme.fonts[DEBUGINATOR_ItemTitleActive], debuginator->app_user_data);
 				underline_size.x = letter_text_size.x;
 				if (letter[0] != ' ') {
 					DebuginatorVector2 underline_pos = debuginator__vector2(filter_pos.x, filter_pos.y - 5);
-					debuginator->draw_rect(&underline_pos, &underline_size, &debuginator->theme.colors[DEBUGINATOR_ItemValueHot], debuginator->app_user_data);
+					debuginator_draw_rect(debuginator, &underline_pos, &underline_size, &debuginator->theme.colors[DEBUGINATOR_ItemValueHot]);
 				}
 				filter_pos.x += letter_text_size.x;
 			}
 		}
 		else {
-			debuginator->draw_text(debuginator->filter, &filter_pos, &debuginator->theme.colors[DEBUGINATOR_ItemTitleActive], &debuginator->theme.fonts[DEBUGINATOR_ItemTitleActive], debuginator->app_user_data);
+			debuginator_draw_text(debuginator, debuginator->filter, &filter_pos, &debuginator->theme.colors[DEBUGINATOR_ItemTitleActive], &debuginator->theme.fonts[DEBUGINATOR_ItemTitleActive]);
 			DebuginatorVector2 filter_text_size = debuginator->text_size(debuginator->filter, &debuginator->theme.fonts[DEBUGINATOR_ItemTitleActive], debuginator->app_user_data);
 			filter_pos.x += filter_text_size.x;
 		}
@@ -2067,15 +4215,21 @@ void debuginator_draw(TheDebuginator* debuginator, float dt) {
 			filter_color.g = 250;
 			filter_color.b = 150;
 			filter_color.a = alpha * DEBUGINATOR_sin(debuginator->draw_timer) < 0.5 ? 220 : 50;
-			debuginator->draw_rect(&caret_pos, &caret_size, &filter_color, debuginator->app_user_data);
+			debuginator_draw_rect(debuginator, &caret_pos, &caret_size, &filter_color);
 		}
 		else if (filter_hint_mode) {
 			//filter_pos.x += 50;
 			DebuginatorColor hint_color = header_color;
 			hint_color.a = (unsigned char)(hint_color.a * alpha);
-			debuginator->draw_text("(backspace)", &filter_pos, &hint_color, &debuginator->theme.fonts[DEBUGINATOR_ItemTitleActive], debuginator->app_user_data);
+			debuginator_draw_text(debuginator, "(backspace)", &filter_pos, &hint_color, &debuginator->theme.fonts[DEBUGINATOR_ItemTitleActive]);
 		}
 	}
+
+	if (debuginator->filter_timer != filter_timer_before) {
+		debuginator->drawn_frame_animating = true;
+	}
+
+	return changed;
 }
 
 float debuginator_draw_item(TheDebuginator* debuginator, DebuginatorItem* item, DebuginatorVector2 offset, bool hot) {
@@ -2084,11 +4238,11 @@ float debuginator_draw_item(TheDebuginator* debuginator, DebuginatorItem* item,
 			DebuginatorVector2 highlight_pos = debuginator__vector2(debuginator->top_left.x, offset.y - 5);
 			//DebuginatorVector2 highlight_pos = debuginator__vector2(debuginator, offset.y - 5);
 			DebuginatorVector2 highlight_size = debuginator__vector2(500, (float)debuginator->item_height);
-			debuginator->draw_rect(&highlight_pos, &highlight_size, &debuginator->theme.colors[DEBUGINATOR_LineHighlight], debuginator->app_user_data);
+			debuginator_draw_rect(debuginator, &highlight_pos, &highlight_size, &debuginator->theme.colors[DEBUGINATOR_LineHighlight]);
 		}
 
 		unsigned color_index = item == debuginator->hot_item ? DEBUGINATOR_ItemTitleActive : (hot ? DEBUGINATOR_ItemTitleHot : DEBUGINATOR_FolderTitle);
-		debuginator->draw_text(item->title, &offset, &debuginator->theme.colors[color_index], &debuginator->theme.fonts[DEBUGINATOR_ItemTitle], debuginator->app_user_data);
+		debuginator_draw_text(debuginator, item->title, &offset, &debuginator->theme.colors[color_index], &debuginator->theme.fonts[DEBUGINATOR_ItemTitle]);
 		offset.x += 20;
 		DebuginatorItem* child = debuginator__first_visible_child(item);
 		while (child) {
@@ -2106,14 +4260,14 @@ float debuginator_draw_item(TheDebuginator* debuginator, DebuginatorItem* item,
 			DebuginatorVector2 highlight_pos = debuginator__vector2(debuginator->top_left.x, offset.y - 5);
 			//DebuginatorVector2 line_pos = debuginator__vector2(debuginator->openness * 500 - 500, offset.y - 5);
 			DebuginatorVector2 highlight_size = debuginator__vector2(500, (float)debuginator->item_height);
-			debuginator->draw_rect(&highlight_pos, &highlight_size, &debuginator->theme.colors[DEBUGINATOR_LineHighlight], debuginator->app_user_data);
+			debuginator_draw_rect(debuginator, &highlight_pos, &highlight_size, &debuginator->theme.colors[DEBUGINATOR_LineHighlight]);
 		}
 
 		bool is_overriden = item->leaf.active_index != item->leaf.default_index && !debuginator->edit_types[item->leaf.edit_type].forget_state;
 		unsigned default_color_index = is_overriden ? DEBUGINATOR_ItemTitleOverridden : DEBUGINATOR_ItemTitle;
 		unsigned color_index = item == debuginator->hot_item && !item->leaf.is_expanded ? DEBUGINATOR_ItemTitleActive : (hot ? DEBUGINATOR_ItemTitleHot : default_color_index);
 		DebuginatorFont* font = &debuginator->theme.fonts[DEBUGINATOR_ItemTitle];
-		debuginator->draw_text(item->title, &offset, &debuginator->theme.colors[color_index], font, debuginator->app_user_data);
+		debuginator_draw_text(debuginator, item->title, &offset, &debuginator->theme.colors[color_index], font);
 
 		if (debuginator->edit_types[item->leaf.edit_type].quick_draw != NULL) {
 			debuginator->edit_types[item->leaf.edit_type].quick_draw(debuginator, item, &offset);
@@ -2122,31 +4276,20 @@ float debuginator_draw_item(TheDebuginator* debuginator, DebuginatorItem* item,
 		if (item->leaf.is_expanded) {
 			offset.x += 20;
 
-			const char* description = item->leaf.description;
-			float description_width = debuginator->top_left.x + debuginator->size.x - 50 - offset.x;
-			char description_line_to_draw[64];
-			int description_height = 0;
-			unsigned row_lengths[32];
-			unsigned row_count = 0;
-			debuginator->word_wrap(description, debuginator->theme.fonts[DEBUGINATOR_ItemDescription], description_width, &row_count, row_lengths, 32, debuginator->app_user_data);
-			unsigned row_index = 0;
-			for (unsigned i = 0; i < row_count; i++) {
-				unsigned row_index_end = row_index + row_lengths[i];
-				const char* description_line = description + row_index;
-				DEBUGINATOR_strncpy_s(description_line_to_draw, 64, description_line, DEBUGINATOR_min(row_index_end - row_index, 64));
-				row_index = row_index_end;
-				while (description[row_index] == '\n') {
-					++row_index;
-				}
+			DebuginatorWordWrapCacheEntry* wrapped_description = debuginator__word_wrap_description(debuginator, item);
+			for (unsigned i = 0; i < wrapped_description->row_count; i++) {
+				const char* description_line = wrapped_description->text + wrapped_description->row_offsets[i];
 				offset.y += debuginator->item_height;
-				description_height += debuginator->item_height;
-				debuginator->draw_text(description_line_to_draw, &offset, &debuginator->theme.colors[DEBUGINATOR_ItemDescription], &debuginator->theme.fonts[DEBUGINATOR_ItemDescription], debuginator->app_user_data);
+				debuginator_draw_text(debuginator, description_line, &offset, &debuginator->theme.colors[DEBUGINATOR_ItemDescription], &debuginator->theme.fonts[DEBUGINATOR_ItemDescription]);
 			}
 
-			// Feels kinda ugly to do this here but... works for now.
-			debuginator__set_total_height(item, debuginator->item_height + description_height + debuginator->item_height * (item->leaf.num_values));
+			// The wrapping changes if the menu is resized or the theme changes, so keep the height in sync.
+			// This hits the word wrap cache.
+			debuginator__set_total_height(debuginator, item, debuginator__expanded_height(debuginator, item));
 
-			debuginator->edit_types[item->leaf.edit_type].expanded_draw(debuginator, item, &offset);
+			if (debuginator->edit_types[item->leaf.edit_type].expanded_draw != NULL) {
+				debuginator->edit_types[item->leaf.edit_type].expanded_draw(debuginator, item, &offset);
+			}
 
 		}
 	}
@@ -2159,22 +4302,101 @@ bool debuginator_is_open(TheDebuginator* debuginator) {
 }
 
 void debuginator_set_open(TheDebuginator* debuginator, bool is_open) {
+	if (is_open && !debuginator->is_open && debuginator->openness == 0) {
+		// Update doesn't scroll while closed, so start out where the hot item is.
+		debuginator->current_height_offset = debuginator__wanted_height_offset(debuginator);
+	}
+
 	debuginator->is_open = is_open;
 	if (debuginator->on_opened_changed) {
 		debuginator->on_opened_changed(is_open, false, debuginator->app_user_data);
 	}
 }
 
+void debuginator__call_item_changed(TheDebuginator* debuginator, DebuginatorItem* item, int value_index) {
+	if (value_index < 0) {
+		item->leaf.on_item_changed_callback(item, NULL, NULL, debuginator->app_user_data);
+	}
+	else {
+		void* value = debuginator__value_pointer(item, value_index);
+		item->leaf.on_item_changed_callback(item, value, debuginator__value_title(debuginator, item, value_index), debuginator->app_user_data);
+	}
+
+	DEBUGINATOR_atomic_store(&debuginator->settings_epoch, debuginator->settings_epoch + 1);
+}
+
+unsigned debuginator_get_settings_epoch(TheDebuginator* debuginator) {
+	return DEBUGINATOR_atomic_load(&debuginator->settings_epoch);
+}
+
+void debuginator__item_changed(TheDebuginator* debuginator, DebuginatorItem* item, int value_index) {
+	if (item->leaf.on_item_changed_callback == NULL) {
+		return;
+	}
+
+	if (!debuginator->defer_callbacks) {
+		debuginator__call_item_changed(debuginator, item, value_index);
+		return;
+	}
+
+	item->leaf.deferred_index = value_index;
+	if (item->leaf.has_deferred_callback) {
+		return;
+	}
+
+	item->leaf.has_deferred_callback = true;
+	item->leaf.next_deferred = NULL;
+	if (debuginator->last_deferred_item != NULL) {
+		debuginator->last_deferred_item->leaf.next_deferred = item;
+	}
+	else {
+		debuginator->first_deferred_item = item;
+	}
+
+	debuginator->last_deferred_item = item;
+}
+
+int debuginator_flush_item_changed_callbacks(TheDebuginator* debuginator) {
+	int num_called = 0;
+	while (debuginator->first_deferred_item != NULL) {
+		DebuginatorItem* item = debuginator->first_deferred_item;
+		debuginator->first_deferred_item = item->leaf.next_deferred;
+		if (debuginator->first_deferred_item == NULL) {
+			debuginator->last_deferred_item = NULL;
+		}
+
+		item->leaf.has_deferred_callback = false;
+		item->leaf.next_deferred = NULL;
+		debuginator__call_item_changed(debuginator, item, item->leaf.deferred_index);
+		num_called++;
+	}
+
+	return num_called;
+}
+
+void debuginator_set_deferred_callbacks(TheDebuginator* debuginator, bool deferred) {
+	debuginator->defer_callbacks = deferred;
+	if (!deferred) {
+		debuginator_flush_item_changed_callbacks(debuginator);
+	}
+}
+
 void debuginator_activate(TheDebuginator* debuginator, DebuginatorItem* item, bool animate) {
 	item->leaf.draw_t = 0;
+	debuginator_request_redraw(debuginator);
 	if (item->leaf.num_values == 0) {
-		if (item->leaf.on_item_changed_callback != NULL) {
-			item->leaf.on_item_changed_callback(item, NULL, NULL, debuginator->app_user_data);
-		}
+		debuginator__item_changed(debuginator, item, -1);
 		return;
 	}
 
 	item->leaf.active_index = item->leaf.hot_index;
+	debuginator__update_overridden(debuginator, item);
+
+	if (!item->leaf.is_dirty && !debuginator->edit_types[item->leaf.edit_type].forget_state) {
+		item->leaf.is_dirty = true;
+		item->leaf.next_dirty = debuginator->first_dirty_item;
+		debuginator->first_dirty_item = item;
+	}
 
 	if (animate) {
 		DebuginatorAnimation* animation = debuginator__get_free_animation(debuginator);
@@ -2194,18 +4416,16 @@ void debuginator_activate(TheDebuginator* debuginator, DebuginatorItem* item, bo
 			int y_dist_to_root = 0;
 			debuginator__distance_to_hot_item(debuginator->root, item, debuginator->item_height, &y_dist_to_root);
 			animation->data.item_activate.start_pos.y = y_dist_to_root + debuginator->current_height_offset - debuginator->item_height; // whyyy
+			animation->target_distance = y_dist_to_root;
+			animation->target_hot_index = item->leaf.hot_index;
+			animation->target_generation = debuginator->layout_generation;
 			if (item->leaf.is_expanded) {
 				animation->data.item_activate.start_pos.y += debuginator->item_height;
 			}
 		}
 	}
 
-	if (item->leaf.on_item_changed_callback == NULL) {
-		return;
-	}
-
-	void* value = ((char*)item->leaf.values) + item->leaf.hot_index * item->leaf.array_element_size;
-	item->leaf.on_item_changed_callback(item, value, item->leaf.value_titles[item->leaf.hot_index], debuginator->app_user_data);
+	debuginator__item_changed(debuginator, item, item->leaf.hot_index);
 }
 
 void debuginator_move_sibling_previous(TheDebuginator* debuginator) {
@@ -2387,7 +4607,8 @@ void debuginator_move_to_child(TheDebuginator* debuginator, bool toggle_and_acti
 		}
 		else {
 			hot_item->leaf.is_expanded = true;
-			debuginator__set_total_height(hot_item, debuginator->item_height * (hot_item->leaf.num_values) + debuginator->item_height); // for description, HACK! :(
+			debuginator__set_total_height(debuginator, hot_item, debuginator__expanded_height(debuginator, hot_item));
+			debuginator__invalidate_layout(debuginator);
 		}
 	}
 	else {
@@ -2411,7 +4632,8 @@ void debuginator_move_to_parent(TheDebuginator* debuginator) {
 	DebuginatorItem* hot_item_new = debuginator->hot_item;
 	if (!hot_item->is_folder && hot_item->leaf.is_expanded) {
 		hot_item->leaf.is_expanded = false;
-		debuginator__set_total_height(hot_item, debuginator->item_height);
+		debuginator__set_total_height(debuginator, hot_item, debuginator->item_height);
+		debuginator__invalidate_layout(debuginator);
 	}
 	else if (hot_item->parent != debuginator->root) {
 		hot_item_new = debuginator->hot_item->parent;
@@ -2429,7 +4651,8 @@ void debuginator_move_to_root(TheDebuginator* debuginator) {
 		DebuginatorItem* hot_item_new = debuginator->hot_item;
 		if (!hot_item->is_folder && hot_item->leaf.is_expanded) {
 			hot_item->leaf.is_expanded = false;
-			debuginator__set_total_height(hot_item, debuginator->item_height);
+			debuginator__set_total_height(debuginator, hot_item, debuginator->item_height);
+			debuginator__invalidate_layout(debuginator);
 		}
 		else if (hot_item->parent != debuginator->root) {
 			hot_item_new = debuginator->hot_item->parent;
@@ -2485,6 +4708,7 @@ DebuginatorItem *debuginator__find_closest_by_height(TheDebuginator *debuginator
 						if (descendent_distance > 0) {
 							last_child->leaf.active_index = i;
 							last_child->leaf.hot_index = last_child->leaf.active_index;
+							debuginator__update_overridden(debuginator, last_child);
 							break;
 						}
 					}
@@ -2513,6 +4737,7 @@ DebuginatorItem *debuginator__find_closest_by_height(TheDebuginator *debuginator
 			if (descendent_distance > 0) {
 				last_child->leaf.active_index = i;
 				last_child->leaf.hot_index = last_child->leaf.active_index;
+				debuginator__update_overridden(debuginator, last_child);
 				break;
 			}
 		}
@@ -2531,7 +4756,8 @@ void debuginator_activate_closest_by_height(TheDebuginator *debuginator, int hei
 			if (item->leaf.hot_index == -1) {
 				item->leaf.is_expanded = false;
 				item->leaf.hot_index = item->leaf.active_index;
-				debuginator__set_total_height(item, debuginator->item_height);
+				debuginator__set_total_height(debuginator, item, debuginator->item_height);
+				debuginator__invalidate_layout(debuginator);
 			} else {
 				if (++item->leaf.hot_index == item->leaf.num_values) {
 					item->leaf.hot_index = 0;
@@ -2540,7 +4766,8 @@ void debuginator_activate_closest_by_height(TheDebuginator *debuginator, int hei
 			}
 		} else {
 			item->leaf.is_expanded = true;
-			debuginator__set_total_height(item, debuginator->item_height * (item->leaf.num_values) + debuginator->item_height); // for description, HACK! :(
+			debuginator__set_total_height(debuginator, item, debuginator__expanded_height(debuginator, item));
+			debuginator__invalidate_layout(debuginator);
 		}
 	}
 }
@@ -2561,23 +4788,92 @@ void debuginator_copy_1byte(DebuginatorItem* item, void* value, const char* valu
 
 DebuginatorItem* debuginator_create_bool_item(TheDebuginator* debuginator, const char* path, const char* description, void* user_data) {
 	bool value_before_creation = *(bool*)user_data;
-	static bool bool_values[2] = { false, true };
-	static const char* bool_titles[2] = { "False", "True" };
-	DEBUGINATOR_assert(sizeof(bool_values[0]) == 1);
-	DebuginatorItem* item = debuginator_create_array_item(debuginator, NULL, path,
+	DEBUGINATOR_assert(sizeof(debuginator->bool_values[0]) == 1);
+	DebuginatorItem* item = debuginator__create_leaf(debuginator, NULL, path,
 		description, debuginator_copy_1byte, user_data,
-		bool_titles, bool_values, 2, sizeof(bool_values[0]));
+		debuginator->bool_titles, debuginator->bool_values, 2, sizeof(debuginator->bool_values[0]), NULL, value_before_creation ? 1 : 0);
 	item->leaf.edit_type = DEBUGINATOR_EditTypeBoolean;
+	debuginator__invalidate_layout(debuginator);
+	return item;
+}
+
+unsigned debuginator__atomic_bits(const void* value, int value_size) {
+	if (value_size == 1) {
+		return *(const uint8_t*)value;
+	}
+	if (value_size == 2) {
+		return *(const uint16_t*)value;
+	}
+
+	DEBUGINATOR_assert(value_size == 4);
+	uint32_t bits;
+	DEBUGINATOR_memcpy(&bits, value, 4);
+	return bits;
+}
+
+void debuginator_store_atomic(DebuginatorItem* item, void* value, const char* value_title, void* app_userdata) {
+	(void)value_title;
+	(void)app_userdata;
+	volatile unsigned* target = (volatile unsigned*)item->user_data;
+	DEBUGINATOR_atomic_store(target, debuginator__atomic_bits(value, item->leaf.array_element_size));
+}
 
-	if (value_before_creation == true) {
-		item->leaf.default_index = 1;
-		item->leaf.hot_index = 1;
-		item->leaf.active_index = 1;
+DebuginatorItem* debuginator__create_atomic_item(TheDebuginator* debuginator, const char* path, const char* description, volatile unsigned* target, const char** value_titles, void* values, int num_values, int value_size, DebuginatorItemEditorDataType edit_type) {
+	unsigned bits_before_creation = *target;
+	int default_index = -1;
+	for (int i = 0; i < num_values; i++) {
+		if (debuginator__atomic_bits((char*)values + i * value_size, value_size) == bits_before_creation) {
+			default_index = i;
+			break;
+		}
 	}
 
+	DebuginatorItem* item = debuginator__create_leaf(debuginator, NULL, path,
+		description, debuginator_store_atomic, (void*)target,
+		value_titles, values, num_values, value_size, NULL, default_index);
+	item->leaf.edit_type = edit_type;
+	debuginator__invalidate_layout(debuginator);
 	return item;
 }
 
+DebuginatorItem* debuginator_create_atomic_bool_item(TheDebuginator* debuginator, const char* path, const char* description, DebuginatorAtomicBool* target) {
+	DEBUGINATOR_assert(sizeof(debuginator->bool_values[0]) == 1);
+	return debuginator__create_atomic_item(debuginator, path, description, &target->bits,
+		debuginator->bool_titles, debuginator->bool_values, 2, sizeof(debuginator->bool_values[0]), DEBUGINATOR_EditTypeBoolean);
+}
+
+DebuginatorItem* debuginator_create_atomic_int_item(TheDebuginator* debuginator, const char* path, const char* description, DebuginatorAtomicInt* target, const char** value_titles, int* values, int num_values) {
+	DEBUGINATOR_assert(sizeof(int) == 4);
+	return debuginator__create_atomic_item(debuginator, path, description, &target->bits,
+		value_titles, values, num_values, sizeof(int), DEBUGINATOR_EditTypeArray);
+}
+
+DebuginatorItem* debuginator_create_atomic_float_item(TheDebuginator* debuginator, const char* path, const char* description, DebuginatorAtomicFloat* target, const char** value_titles, float* values, int num_values) {
+	DEBUGINATOR_assert(sizeof(float) == 4);
+	return debuginator__create_atomic_item(debuginator, path, description, &target->bits,
+		value_titles, values, num_values, sizeof(float), DEBUGINATOR_EditTypeArray);
+}
+
+DebuginatorItem* debuginator_create_atomic_enum_item(TheDebuginator* debuginator, const char* path, const char* description, DebuginatorAtomicInt* target, const char** value_titles, void* values, int num_values, int value_size) {
+	return debuginator__create_atomic_item(debuginator, path, description, &target->bits,
+		value_titles, values, num_values, value_size, DEBUGINATOR_EditTypeArray);
+}
+
+bool debuginator_atomic_bool_get(const DebuginatorAtomicBool* target) {
+	return DEBUGINATOR_atomic_load(&target->bits) != 0;
+}
+
+int debuginator_atomic_int_get(const DebuginatorAtomicInt* target) {
+	return (int)DEBUGINATOR_atomic_load(&target->bits);
+}
+
+float debuginator_atomic_float_get(const DebuginatorAtomicFloat* target) {
+	unsigned bits = DEBUGINATOR_atomic_load(&target->bits);
+	float value;
+	DEBUGINATOR_memcpy(&value, &bits, sizeof(value));
+	return value;
+}
+
 void debuginator_activate_preset(DebuginatorItem* item, void* value, const char* value_title, void* app_userdata) {
 	(void)value_title;
 	(void)app_userdata;
@@ -2592,17 +4888,15 @@ void debuginator_activate_preset(DebuginatorItem* item, void* value, const char*
 			continue;
 		}
 
-		const char* preset_value_title = preset_value_titles[i];
-		for (int value_i = 0; value_i < item_to_activate->leaf.num_values; value_i++) {
-			if (strcmp(item_to_activate->leaf.value_titles[value_i], preset_value_title) == 0) {
-				item_to_activate->leaf.hot_index = value_i;
-				debuginator_activate(debuginator, item_to_activate, true);
-				break;
-			}
+		int value_index = debuginator__find_value_by_title(debuginator, item_to_activate, preset_value_titles[i]);
+		if (value_index >= 0) {
+			item_to_activate->leaf.hot_index = value_index;
+			debuginator_activate(debuginator, item_to_activate, true);
 		}
 	}
 
 	item->leaf.active_index = 0;
+	debuginator__update_overridden(debuginator, item);
 }
 
 DebuginatorItem* debuginator_create_preset_item(TheDebuginator* debuginator, const char* path, const char** paths, const char** value_titles, int** value_indices, int num_paths) {